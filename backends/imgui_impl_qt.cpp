@@ -9,6 +9,17 @@
 //  ImGui::IsKeyPressed(ImGuiKey_Space).
 //  [X] Platform: Mouse cursor shape and visibility. Disable with
 //  'io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange'.
+//  [X] Platform: Tablet and touch support, with per-frame pressure samples. See
+//  ImGui_ImplQt_GetPointerSamples().
+//  [X] Platform: Opt-in pointer motion prediction. See
+//  ImGui_ImplQt_SetPointerPrediction().
+//  [X] Platform: Multi-viewport support (multiple windows). Enable with
+//  'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'. Native windows are
+//  pooled and reused.
+//  [X] Platform: Settings of all registered objects persisted in a single file,
+//  written asynchronously. See ImGui_ImplQt_SetSettingsFile().
+//  [X] Renderer: QImage/QPixmap texture registry with LRU eviction and partial
+//  uploads. Requires texture callbacks, see ImGui_ImplQt_TextureCallbacks.
 
 // You can use unmodified imgui_impl_* files in your project. See examples/
 // folder for examples of using this. Prefer including the entire imgui/
@@ -19,19 +30,43 @@
 
 #include "imgui_impl_qt.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <deque>
+#include <list>
+#include <unordered_set>
 
 #include <QApplication>
 #include <QClipboard>
+#include <QCursor>
+#include <QElapsedTimer>
 #include <QEnterEvent>
 #include <QEvent>
+#include <QFile>
 #include <QFocusEvent>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QKeyEvent>
 #include <QMouseEvent>
+#include <QPixmap>
+#include <QRegion>
+#include <QSaveFile>
+#include <QScreen>
+#include <QTabletEvent>
+#include <QThreadPool>
+#include <QTimer>
+#include <QTouchEvent>
 #include <QWheelEvent>
 #include <QWidget>
 #include <QWindow>
 
+#if QT_CONFIG(opengl)
+#   include <QOpenGLContext>
+#endif
+
 #ifndef IMGUI_HAS_DOCK
 #   define ImGuiConfigFlags_ViewportsEnable 0
 #endif
@@ -42,8 +77,121 @@ namespace ImGui
 void DebugLog(const char* fmt, ...);
 }
 
+class ImGuiQtBackend;
 struct ImGui_ImplQt_Data;
 
+// Pending tablet and touch samples kept for an object which is not rendered
+static constexpr std::size_t kMaxPointerSamples_ = 4096u;
+
+// Pending input events kept for an object which is not rendered
+static constexpr std::size_t kMaxQueuedEvents_ = 1024u;
+
+// Pending events posted from other threads to an object which is not rendered
+static constexpr int kMaxPostedEvents_ = 4096;
+
+// Pointer positions kept per object for motion prediction
+static constexpr std::size_t kMaxPointerHistory_ = 16u;
+
+// Pointer velocity is estimated over positions within this window. Without any
+// position within this window, the pointer is considered at rest.
+static constexpr std::chrono::milliseconds kPredictionWindow_ {50};
+
+// Predictions are never extrapolated further than this past the last position
+static constexpr std::chrono::milliseconds kMaxPredictionHorizon_ {50};
+
+// Weight of a new prediction error in the moving average of the error
+static constexpr float kPredictionErrorWeight_ = 0.1f;
+
+// Set of event types, built at compile time, to filter events with a single
+// lookup before any dispatch. Event types must be below kBits_.
+class ImGuiQtEventMask
+{
+public:
+   constexpr ImGuiQtEventMask(std::initializer_list<QEvent::Type> types)
+   {
+      for (QEvent::Type type : types)
+      {
+         words_[type / 64u] |= ImU64 {1u} << (type % 64u);
+      }
+   }
+
+   constexpr bool Contains(QEvent::Type type) const
+   {
+      return static_cast<unsigned int>(type) < kBits_ &&
+             ((words_[type / 64u] >> (type % 64u)) & 1u) != 0u;
+   }
+
+private:
+   static constexpr unsigned int kBits_ = 256u;
+
+   ImU64 words_[kBits_ / 64u] {};
+};
+
+// Events processed by ImGuiQtBackend::eventFilter(). All other events received
+// by registered objects (paint, timer, layout requests, ...) are passed through
+// without any further lookup.
+static constexpr ImGuiQtEventMask kFilteredEvents_ {
+   QEvent::Enter,
+   QEvent::Leave,
+   QEvent::FocusIn,
+   QEvent::FocusOut,
+   QEvent::KeyPress,
+   QEvent::KeyRelease,
+   QEvent::MouseButtonPress,
+   QEvent::MouseButtonRelease,
+   QEvent::MouseMove,
+   QEvent::HoverEnter,
+   QEvent::HoverMove,
+   QEvent::HoverLeave,
+   QEvent::Wheel,
+   QEvent::TabletPress,
+   QEvent::TabletMove,
+   QEvent::TabletRelease,
+   QEvent::TouchBegin,
+   QEvent::TouchUpdate,
+   QEvent::TouchEnd,
+   QEvent::TouchCancel,
+#ifdef IMGUI_HAS_DOCK
+   // Viewport window events
+   QEvent::Close,
+   QEvent::Move,
+   QEvent::Resize,
+   QEvent::Expose,
+#endif
+};
+
+// Lock-free multiple producer, single consumer queue of events posted to a
+// registered object. Producers may be on any thread, the consumer is
+// ImGuiQtBackend::NewFrame() on the GUI thread. Only the wake-up of the GUI
+// thread takes a lock, at most once per frame.
+struct ImGui_ImplQt_EventChannel
+{
+   struct Node
+   {
+      std::atomic<Node*>            next_ {};
+      std::function<void(ImGuiIO&)> event_ {};
+   };
+
+   ImGui_ImplQt_EventChannel() : head_ {&stub_}, tail_ {&stub_} {}
+   ~ImGui_ImplQt_EventChannel();
+
+   void  Push(Node* node);
+   Node* Pop();
+   void  Wake();
+
+   std::atomic<Node*> head_;
+   Node*              tail_;
+   Node               stub_ {};
+
+   std::atomic<int>  size_ {};
+   std::atomic<bool> closed_ {};
+   std::atomic<bool> frameRequested_ {};
+
+   // Only accessed from the GUI thread
+   QObject*        object_ {};
+   ImGuiQtBackend* backend_ {};
+};
+
 class ImGuiQtBackend : public QObject
 {
 private:
@@ -60,6 +208,7 @@ public:
 
    template<class T>
    void NewFrame(T* object);
+   void NewFrame(QObject* object, ImVec2 displaySize, float framebufferScale);
 
    void UpdateKeyModifiers(QObject* watched, Qt::KeyboardModifiers modifiers);
    void UpdateMouseCursor();
@@ -71,6 +220,33 @@ public:
    void MonitorCallback();
 
    void RegisterObject(QObject* object);
+   void UnregisterObject(QObject* object);
+   void SetUpdateCallback(QObject* object, std::function<void()> callback);
+   void SetCursorCallback(QObject*                            object,
+                          std::function<void(const QCursor&)> callback);
+   void RequestUpdate(QObject* object);
+
+   const std::vector<ImGui_ImplQt_PointerSample>& PointerSamples() const;
+
+   ImGui_ImplQt_EventHandle EventHandle(QObject* object) const;
+
+   ImGui_ImplQt_BackendStats Stats() const;
+
+   void SaveSettings(QObject* object);
+
+   void SetPointerPrediction(bool enabled);
+
+#ifdef IMGUI_HAS_DOCK
+   void   CreateViewportWindow(ImGuiViewport* viewport);
+   void   DestroyViewportWindow(ImGuiViewport* viewport);
+   void   UpdateViewportWindow(ImGuiViewport* viewport);
+   void   RenderViewportWindow(ImGuiViewport* viewport);
+   void   SwapViewportBuffers(ImGuiViewport* viewport);
+   void   IgnoreViewportMoveEvent(ImGuiViewport* viewport);
+   void   IgnoreViewportResizeEvent(ImGuiViewport* viewport);
+   static Qt::WindowFlags
+   ViewportFlagsToWindowFlags(ImGuiViewportFlags viewportFlags);
+#endif
 
    static ImGuiMouseButton
                           ButtonToImGuiMouseButton(Qt::MouseButton mouseButton);
@@ -82,32 +258,222 @@ private:
    void HandleLeave(QObject* watched, QEvent* event);
    void HandleFocus(QObject* watched, QFocusEvent* event);
    void HandleKeyPress(QObject* watched, QKeyEvent* event);
-   void HandleMouseMove(QObject* watched, QMouseEvent* event);
+   void HandleMouseMove(QObject* watched, QSinglePointEvent* event);
    void HandleMouseButtonPress(QObject* watched, QMouseEvent* event);
    void HandleWheel(QObject* watched, QWheelEvent* event);
+   void HandleTablet(QObject* watched, QTabletEvent* event);
+
+   void QueueEvent(QObject*              watched,
+                   std::function<void()> event,
+                   bool                  move = false);
+   void TrimEventQueue(QObject* watched);
+   void HandleTouch(QObject* watched, QTouchEvent* event);
+
+   void QueuePointerMove(QObject*         watched,
+                         ImGuiMouseSource source,
+                         ImVec2           pos,
+                         quint64          timestamp);
+   void QueuePointerButton(QObject*         watched,
+                           ImGuiMouseSource source,
+                           ImVec2           pos,
+                           ImGuiMouseButton button,
+                           bool             down);
+   void AddPointerSample(QObject*                          watched,
+                         const ImGui_ImplQt_PointerSample& sample);
+
+   void RecordPointerPosition(QObject* watched, ImVec2 pos, quint64 timestamp);
+   std::chrono::steady_clock::time_point EventTime(quint64 timestamp);
+   void ResetPointerPrediction(QObject* watched, ImVec2 pos);
+   void PredictPointerPosition(QObject*                              object,
+                               std::chrono::steady_clock::time_point frameTime);
+
+   struct QueuedEvent
+   {
+      std::function<void()> event_ {};
+
+      // Pointer moves are superseded by a following move
+      bool move_ {};
+   };
+
+   struct PointerPosition
+   {
+      std::chrono::steady_clock::time_point time_ {};
+      ImVec2                                position_ {};
+   };
+
+   struct PointerBuffer
+   {
+      // Samples received since the last frame, and samples of the last frame
+      std::vector<ImGui_ImplQt_PointerSample> pending_ {};
+      std::vector<ImGui_ImplQt_PointerSample> frame_ {};
+
+      // Position of the queued, coalesced pointer move event
+      std::shared_ptr<ImVec2> queuedMove_ {};
+
+      // Touch point driving the ImGui mouse, -1 without touch
+      int touchPointId_ {-1};
+
+      // Recent pointer positions, and the last predicted position. The error
+      // of the prediction is pending until the pointer is sampled past the
+      // predicted time.
+      std::deque<PointerPosition> history_ {};
+      PointerPosition             prediction_ {};
+      bool                        predictionPending_ {};
+      bool                        positionPredicted_ {};
+   };
+
+#ifdef IMGUI_HAS_DOCK
+   bool HandleViewportEvent(ImGuiViewport* viewport, QEvent* event);
+
+   QWindow* AcquireViewportWindow(Qt::WindowFlags flags);
+   void     ReleaseViewportWindow(QWindow* window);
+
+   // Hidden native windows kept for reuse by new viewports
+   std::vector<QWindow*>                        windowPool_ {};
+   std::unordered_map<QObject*, ImGuiViewport*> viewportWindows_ {};
+
+#   if QT_CONFIG(opengl)
+   std::unique_ptr<QOpenGLContext> viewportContext_ {};
+   QOpenGLContext*                 previousContext_ {};
+   QSurface*                       previousSurface_ {};
+#   endif
+#endif
 
    ImGuiIO&           io_;
    ImGui_ImplQt_Data* bd_;
 
-   std::unordered_map<QObject*, std::deque<std::function<void()>>> eventQueue_;
+   std::unordered_map<QObject*, std::deque<QueuedEvent>> eventQueue_;
+   std::unordered_map<QObject*, PointerBuffer> pointerBuffers_ {};
+   std::unordered_map<QObject*, ImGui_ImplQt_EventHandle> eventChannels_ {};
+   std::unordered_map<QObject*, std::string>              settingsKeys_ {};
+   std::unordered_map<QObject*, std::function<void()>>    updateCallbacks_ {};
+   std::unordered_map<QObject*, std::function<void(const QCursor&)>>
+      cursorCallbacks_ {};
 
    std::chrono::steady_clock::time_point time_ {};
    bool                                  debugEnabled_ {};
    bool                                  wantUpdateMonitors_ {};
+   int                                   frameCount_ {};
+   QObject*                              mainObject_ {};
    QObject*                              focusedObject_ {};
    QObject*                              keyboardObject_ {};
    QObject*                              mouseObject_ {};
+   ImU64                                 droppedEvents_ {};
+   float                                 newFrameTime_ {};
+   bool                                  pointerPrediction_ {};
+   float                                 predictionError_ {};
+   ImU64                                 predictionCount_ {};
+   std::chrono::steady_clock::duration   eventTimeOffset_ {};
+   quint64                               lastEventTimestamp_ {};
    ImVec2 lastValidMousePosition_ {-FLT_MAX, -FLT_MAX};
 };
 
+class ImGuiQtTextureRegistry
+{
+private:
+   Q_DISABLE_COPY(ImGuiQtTextureRegistry)
+
+public:
+   explicit ImGuiQtTextureRegistry() = default;
+   ~ImGuiQtTextureRegistry()         = default;
+
+   ImTextureID GetTexture(const QImage& image, const QRegion* dirtyRegion);
+   ImTextureID GetTexture(const QPixmap& pixmap, const QRegion* dirtyRegion);
+   void        Clear();
+
+   ImGui_ImplQt_TextureCallbacks callbacks_ {};
+   ImGui_ImplQt_TextureStats     stats_ {};
+   std::size_t                   budget_ {64u * 1024u * 1024u};
+
+private:
+   struct Entry
+   {
+      qint64      key_ {};
+      qint64      cacheKey_ {};
+      QSize       size_ {};
+      ImTextureID textureId_ {};
+      int         lastUsedFrame_ {};
+   };
+
+   template<class T>
+   ImTextureID GetTexture(qint64         key,
+                          const T&       source,
+                          const QRegion* dirtyRegion);
+
+   void Upload(Entry& entry, const QImage& image, const QRegion* dirtyRegion);
+   void Upload(Entry& entry, const QPixmap& pixmap, const QRegion* dirtyRegion);
+   bool UpdateRegion(const Entry&   entry,
+                     QSize          size,
+                     const QRegion* dirtyRegion,
+                     QRegion&       region) const;
+   void Create(Entry& entry, const QImage& image);
+   void UpdateRect(Entry&       entry,
+                   const QRect& rect,
+                   const void*  pixels,
+                   int          stride);
+   void Destroy(Entry& entry);
+   void Evict();
+
+   // Most recently used entries are at the front
+   std::list<Entry>                                       entries_ {};
+   std::unordered_map<qint64, std::list<Entry>::iterator> lookup_ {};
+};
+
+// Settings of all registered objects, shared by all contexts. Loaded once, and
+// written asynchronously after changes settle.
+class ImGuiQtSettingsStore : public QObject
+{
+private:
+   Q_DISABLE_COPY(ImGuiQtSettingsStore)
+
+public:
+   explicit ImGuiQtSettingsStore(const QString& filename);
+   ~ImGuiQtSettingsStore();
+
+   static ImGuiQtSettingsStore* Instance();
+   static void                  SetFilename(const QString& filename);
+
+   std::string        AssignKey(QObject* object);
+   void               ReleaseKey(const std::string& key);
+   const std::string& Get(const std::string& key) const;
+   void               Set(const std::string& key, std::string settings);
+
+private:
+   void Load();
+   void Write();
+
+   QString                                      filename_;
+   std::unordered_map<std::string, std::string> settings_ {};
+   std::unordered_set<std::string>              assignedKeys_ {};
+   QTimer                                       writeTimer_ {};
+   QElapsedTimer                                pendingTimer_ {};
+   QThreadPool                                  writePool_ {};
+};
+
 struct ImGui_ImplQt_Data
 {
    std::unique_ptr<ImGuiQtBackend> backend_ {};
    std::string                     clipboard_ {};
 
+   ImGuiQtTextureRegistry textureRegistry_ {};
+
    std::vector<QObject*> registeredObjects_ {};
 };
 
+#ifdef IMGUI_HAS_DOCK
+// Helper structure stored in the void* PlatformUserData field of each
+// ImGuiViewport to easily retrieve our backend data.
+struct ImGui_ImplQt_ViewportData
+{
+   QObject*        object_ {};
+   QWindow*        window_ {};
+   bool            windowOwned_ {};
+   Qt::WindowFlags flags_ {};
+   int             ignoreWindowPosEventFrame_ {-1};
+   int             ignoreWindowSizeEventFrame_ {-1};
+};
+#endif
+
 ImGuiQtBackend::ImGuiQtBackend(ImGuiIO& io, ImGui_ImplQt_Data* bd) :
     io_ {io}, bd_ {bd}
 {
@@ -321,10 +687,55 @@ ImGuiQtBackend::ImGuiCursorToCursorShape(ImGuiMouseCursor cursor)
    return Qt::CursorShape::ArrowCursor;
 }
 
+void ImGuiQtBackend::QueueEvent(QObject*              watched,
+                                std::function<void()> event,
+                                bool                  move)
+{
+   std::deque<QueuedEvent>& queue = eventQueue_.at(watched);
+
+   // Objects which are not rendered never drain their queue
+   if (queue.size() >= kMaxQueuedEvents_)
+   {
+      TrimEventQueue(watched);
+   }
+
+   queue.push_back({std::move(event), move});
+}
+
+void ImGuiQtBackend::TrimEventQueue(QObject* watched)
+{
+   std::deque<QueuedEvent>& queue = eventQueue_.at(watched);
+
+   // Coalesce consecutive pointer moves into the last one, which preserves the
+   // position of the pointer at each button, wheel, key and focus event
+   std::deque<QueuedEvent> coalesced;
+   for (std::size_t i = 0; i < queue.size(); ++i)
+   {
+      if (!queue[i].move_ || i + 1 == queue.size() || !queue[i + 1].move_)
+      {
+         coalesced.push_back(std::move(queue[i]));
+      }
+   }
+   queue.swap(coalesced);
+
+   // Only when the queue holds little else than discrete events, drop the
+   // oldest ones as a last resort
+   if (queue.size() > kMaxQueuedEvents_ / 2u)
+   {
+      std::size_t dropCount = queue.size() - kMaxQueuedEvents_ / 2u;
+      queue.erase(queue.begin(), queue.begin() + dropCount);
+      droppedEvents_ += dropCount;
+   }
+
+   // The queued, coalesced pointer move event may have been removed
+   pointerBuffers_.at(watched).queuedMove_.reset();
+}
+
 void ImGuiQtBackend::UpdateKeyModifiers(QObject*              watched,
                                         Qt::KeyboardModifiers modifiers)
 {
-   eventQueue_.at(watched).push_back(
+   QueueEvent(
+      watched,
       [=]()
       {
          io_.AddKeyEvent(ImGuiMod_Ctrl,
@@ -372,7 +783,13 @@ void ImGuiQtBackend::HandleMouseButtonPress(QObject*     watched,
    mouseObject_           = watched;
    QEvent::Type eventType = event->type();
 
-   eventQueue_.at(watched).push_back(
+   QPointF position = (io_.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) ?
+                         event->globalPosition() :
+                         event->position();
+   ResetPointerPrediction(watched, ImVec2(position.x(), position.y()));
+
+   QueueEvent(
+      watched,
       [=]()
       {
          io_.AddMouseButtonEvent(button,
@@ -387,9 +804,15 @@ void ImGuiQtBackend::HandleWheel(QObject* watched, QWheelEvent* event)
 
    mouseObject_ = watched;
 
+   QPointF position = (io_.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) ?
+                         event->globalPosition() :
+                         event->position();
+   ResetPointerPrediction(watched, ImVec2(position.x(), position.y()));
+
    if (!numPixels.isNull())
    {
-      eventQueue_.at(watched).push_back(
+      QueueEvent(
+         watched,
          [=]()
          {
             io_.AddMouseWheelEvent(static_cast<float>(numPixels.x()),
@@ -398,7 +821,8 @@ void ImGuiQtBackend::HandleWheel(QObject* watched, QWheelEvent* event)
    }
    else if (!numDegrees.isNull())
    {
-      eventQueue_.at(watched).push_back(
+      QueueEvent(
+         watched,
          [=]()
          {
             QPointF numSteps = numDegrees / 15.0f;
@@ -433,7 +857,8 @@ void ImGuiQtBackend::HandleKeyPress(QObject* watched, QKeyEvent* event)
    QEvent::Type eventType = event->type();
    std::string  eventText = event->text().toStdString();
 
-   eventQueue_.at(watched).push_back(
+   QueueEvent(
+      watched,
       [=]()
       {
          io_.AddKeyEvent(imguiKey, eventType == QEvent::Type::KeyPress);
@@ -452,11 +877,13 @@ void ImGuiQtBackend::HandleFocus(QObject* watched, QFocusEvent* event)
    focusedObject_ = event->type() == QEvent::Type::FocusIn ? watched : nullptr;
    QEvent::Type eventType = event->type();
 
-   eventQueue_.at(watched).push_back(
+   QueueEvent(
+      watched,
       [=]() { io_.AddFocusEvent(eventType == QEvent::Type::FocusIn); });
 }
 
-void ImGuiQtBackend::HandleMouseMove(QObject* watched, QMouseEvent* event)
+void ImGuiQtBackend::HandleMouseMove(QObject*           watched,
+                                     QSinglePointEvent* event)
 {
    QPointF position;
 
@@ -472,8 +899,12 @@ void ImGuiQtBackend::HandleMouseMove(QObject* watched, QMouseEvent* event)
    mouseObject_            = watched;
    lastValidMousePosition_ = ImVec2(position.x(), position.y());
 
-   eventQueue_.at(watched).push_back(
-      [=]() { io_.AddMousePosEvent(position.x(), position.y()); });
+   RecordPointerPosition(watched, lastValidMousePosition_, event->timestamp());
+
+   QueueEvent(
+      watched,
+      [=]() { io_.AddMousePosEvent(position.x(), position.y()); },
+      true);
 }
 
 void ImGuiQtBackend::HandleEnter(QObject* watched, QEnterEvent* event)
@@ -492,8 +923,12 @@ void ImGuiQtBackend::HandleEnter(QObject* watched, QEnterEvent* event)
    mouseObject_            = watched;
    lastValidMousePosition_ = ImVec2(position.x(), position.y());
 
-   eventQueue_.at(watched).push_back(
-      [=]() { io_.AddMousePosEvent(position.x(), position.y()); });
+   RecordPointerPosition(watched, lastValidMousePosition_, event->timestamp());
+
+   QueueEvent(
+      watched,
+      [=]() { io_.AddMousePosEvent(position.x(), position.y()); },
+      true);
 }
 
 void ImGuiQtBackend::HandleLeave(QObject* watched, QEvent* /* event */)
@@ -504,8 +939,429 @@ void ImGuiQtBackend::HandleLeave(QObject* watched, QEvent* /* event */)
       lastValidMousePosition_ = io_.MousePos;
    }
 
-   eventQueue_.at(watched).push_back(
-      [=]() { io_.AddMousePosEvent(-FLT_MAX, -FLT_MAX); });
+   PointerBuffer& buffer = pointerBuffers_.at(watched);
+   buffer.history_.clear();
+   buffer.predictionPending_ = false;
+   buffer.positionPredicted_ = false;
+
+   QueueEvent(watched, [=]() { io_.AddMousePosEvent(-FLT_MAX, -FLT_MAX); });
+}
+
+void ImGuiQtBackend::HandleTablet(QObject* watched, QTabletEvent* event)
+{
+   QPointF position;
+
+   if (io_.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+   {
+      position = event->globalPosition();
+   }
+   else
+   {
+      position = event->position();
+   }
+
+   mouseObject_            = watched;
+   lastValidMousePosition_ = ImVec2(position.x(), position.y());
+
+   ImGui_ImplQt_PointerSample sample {};
+   sample.Position  = lastValidMousePosition_;
+   sample.Pressure  = static_cast<float>(event->pressure());
+   sample.TiltX     = static_cast<float>(event->xTilt());
+   sample.TiltY     = static_cast<float>(event->yTilt());
+   sample.Timestamp = static_cast<double>(event->timestamp()) / 1000.0;
+   sample.PointId   = 0;
+   sample.Source    = ImGuiMouseSource_Pen;
+   AddPointerSample(watched, sample);
+
+   if (event->type() == QEvent::Type::TabletMove)
+   {
+      QueuePointerMove(watched,
+                       ImGuiMouseSource_Pen,
+                       sample.Position,
+                       event->timestamp());
+   }
+   else
+   {
+      ImGuiMouseButton button = ButtonToImGuiMouseButton(event->button());
+      if (button != -1)
+      {
+         QueuePointerButton(watched,
+                            ImGuiMouseSource_Pen,
+                            sample.Position,
+                            button,
+                            event->type() == QEvent::Type::TabletPress);
+      }
+   }
+}
+
+void ImGuiQtBackend::HandleTouch(QObject* watched, QTouchEvent* event)
+{
+   const bool viewportsEnabled =
+      (io_.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0;
+   int& touchPointId = pointerBuffers_.at(watched).touchPointId_;
+
+   if (event->type() == QEvent::Type::TouchCancel)
+   {
+      // Cancelled sequences have no points, release at the last position
+      if (touchPointId != -1)
+      {
+         QueuePointerButton(watched,
+                            ImGuiMouseSource_TouchScreen,
+                            lastValidMousePosition_,
+                            ImGuiMouseButton_Left,
+                            false);
+         touchPointId = -1;
+      }
+      return;
+   }
+
+   if (event->type() == QEvent::Type::TouchBegin && !event->points().empty())
+   {
+      // The first touch point drives the ImGui mouse
+      touchPointId = event->points().front().id();
+   }
+
+   for (const QEventPoint& point : event->points())
+   {
+      if (point.state() == QEventPoint::State::Stationary)
+      {
+         continue;
+      }
+
+      QPointF position =
+         viewportsEnabled ? point.globalPosition() : point.position();
+
+      ImGui_ImplQt_PointerSample sample {};
+      sample.Position  = ImVec2(position.x(), position.y());
+      sample.Pressure  = static_cast<float>(point.pressure());
+      sample.Timestamp = static_cast<double>(event->timestamp()) / 1000.0;
+      sample.PointId   = point.id();
+      sample.Source    = ImGuiMouseSource_TouchScreen;
+      AddPointerSample(watched, sample);
+
+      if (point.id() != touchPointId)
+      {
+         continue;
+      }
+
+      mouseObject_            = watched;
+      lastValidMousePosition_ = sample.Position;
+
+      if (point.state() == QEventPoint::State::Pressed ||
+               point.state() == QEventPoint::State::Released)
+      {
+         QueuePointerButton(watched,
+                            ImGuiMouseSource_TouchScreen,
+                            sample.Position,
+                            ImGuiMouseButton_Left,
+                            point.state() == QEventPoint::State::Pressed);
+      }
+      else
+      {
+         QueuePointerMove(watched,
+                          ImGuiMouseSource_TouchScreen,
+                          sample.Position,
+                          event->timestamp());
+      }
+   }
+
+   if (event->type() == QEvent::Type::TouchEnd)
+   {
+      touchPointId = -1;
+   }
+}
+
+void ImGuiQtBackend::AddPointerSample(QObject*                          watched,
+                                      const ImGui_ImplQt_PointerSample& sample)
+{
+   std::vector<ImGui_ImplQt_PointerSample>& pending =
+      pointerBuffers_.at(watched).pending_;
+
+   // Bound the buffer of objects which are not being rendered
+   if (pending.size() >= kMaxPointerSamples_)
+   {
+      pending.erase(pending.begin(), pending.begin() + pending.size() / 2);
+   }
+
+   pending.push_back(sample);
+}
+
+void ImGuiQtBackend::QueuePointerMove(QObject*         watched,
+                                      ImGuiMouseSource source,
+                                      ImVec2           pos,
+                                      quint64          timestamp)
+{
+   PointerBuffer& buffer = pointerBuffers_.at(watched);
+
+   RecordPointerPosition(watched, pos, timestamp);
+
+   // Moves between two button events are coalesced into a single event, which
+   // is sent with the latest position
+   if (buffer.queuedMove_ != nullptr)
+   {
+      *buffer.queuedMove_ = pos;
+      return;
+   }
+
+   std::shared_ptr<ImVec2> queuedMove = std::make_shared<ImVec2>(pos);
+
+   QueueEvent(
+      watched,
+      [=]()
+      {
+         io_.AddMouseSourceEvent(source);
+         io_.AddMousePosEvent(queuedMove->x, queuedMove->y);
+         io_.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+      },
+      true);
+
+   // Set once queued, as queueing may reset it
+   buffer.queuedMove_ = queuedMove;
+}
+
+void ImGuiQtBackend::QueuePointerButton(QObject*         watched,
+                                        ImGuiMouseSource source,
+                                        ImVec2           pos,
+                                        ImGuiMouseButton button,
+                                        bool             down)
+{
+   // Following moves must be sent after this event. The event is applied at
+   // its own position, instead of a predicted position.
+   PointerBuffer& buffer = pointerBuffers_.at(watched);
+   buffer.queuedMove_.reset();
+   buffer.positionPredicted_ = false;
+
+   QueueEvent(
+      watched,
+      [=]()
+      {
+         io_.AddMouseSourceEvent(source);
+         io_.AddMousePosEvent(pos.x, pos.y);
+         io_.AddMouseButtonEvent(button, down);
+         io_.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+      });
+}
+
+void ImGuiQtBackend::RecordPointerPosition(QObject* watched,
+                                           ImVec2   pos,
+                                           quint64  timestamp)
+{
+   if (!pointerPrediction_)
+   {
+      return;
+   }
+
+   PointerBuffer&               buffer  = pointerBuffers_.at(watched);
+   std::deque<PointerPosition>& history = buffer.history_;
+
+   if (history.size() >= kMaxPointerHistory_)
+   {
+      history.pop_front();
+   }
+
+   // Several queued moves may be dispatched at once, use the time the pointer
+   // was sampled instead of the time the event is received
+   history.push_back({EventTime(timestamp), pos});
+
+   // The actual position is queued, replacing any predicted position
+   buffer.positionPredicted_ = false;
+}
+
+std::chrono::steady_clock::time_point
+ImGuiQtBackend::EventTime(quint64 timestamp)
+{
+   auto now = std::chrono::steady_clock::now();
+
+   // Synthesized events may not have a timestamp
+   if (timestamp == 0u)
+   {
+      return now;
+   }
+
+   // Event timestamps are in milliseconds, from an unspecified epoch. Events
+   // are never received before they occur, so the smallest offset to the
+   // steady clock is the closest to the actual time. Restart when the
+   // timestamps go back, e.g. if their source changed.
+   std::chrono::steady_clock::duration eventTime =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+         std::chrono::milliseconds(timestamp));
+   std::chrono::steady_clock::duration offset =
+      now.time_since_epoch() - eventTime;
+
+   if (lastEventTimestamp_ == 0u || timestamp < lastEventTimestamp_ ||
+       offset < eventTimeOffset_)
+   {
+      eventTimeOffset_ = offset;
+   }
+   lastEventTimestamp_ = timestamp;
+
+   return std::chrono::steady_clock::time_point(eventTime + eventTimeOffset_);
+}
+
+void ImGuiQtBackend::ResetPointerPrediction(QObject* watched, ImVec2 pos)
+{
+   // Buttons and wheel events are applied at the actual position of the
+   // pointer, instead of a predicted position
+   PointerBuffer& buffer = pointerBuffers_.at(watched);
+   if (buffer.positionPredicted_)
+   {
+      buffer.positionPredicted_ = false;
+      QueueEvent(
+         watched, [=]() { io_.AddMousePosEvent(pos.x, pos.y); }, true);
+   }
+}
+
+static QScreen* ImGui_ImplQt_GetScreen(QObject* object)
+{
+   QScreen* screen = nullptr;
+
+   if (object->isWidgetType())
+   {
+      screen = reinterpret_cast<QWidget*>(object)->screen();
+   }
+   else if (object->isWindowType())
+   {
+      screen = reinterpret_cast<QWindow*>(object)->screen();
+   }
+
+   return screen != nullptr ? screen : QGuiApplication::primaryScreen();
+}
+
+void ImGuiQtBackend::PredictPointerPosition(
+   QObject* object, std::chrono::steady_clock::time_point frameTime)
+{
+   PointerBuffer&               buffer  = pointerBuffers_.at(object);
+   std::deque<PointerPosition>& history = buffer.history_;
+
+   if (history.empty())
+   {
+      return;
+   }
+
+   // Measure the error of the previous prediction, once the pointer has been
+   // sampled past the predicted time
+   PointerPosition& prediction = buffer.prediction_;
+   if (buffer.predictionPending_ && history.back().time_ >= prediction.time_)
+   {
+      auto after = std::find_if(history.cbegin(),
+                                history.cend(),
+                                [&](const PointerPosition& position)
+                                { return position.time_ >= prediction.time_; });
+
+      // Without a position before the predicted time, the actual position is
+      // unknown
+      if (after != history.cbegin())
+      {
+         auto  before = std::prev(after);
+         float span =
+            std::chrono::duration<float>(after->time_ - before->time_).count();
+         float t =
+            std::chrono::duration<float>(prediction.time_ - before->time_)
+               .count() /
+            span;
+
+         const ImVec2& from = before->position_;
+         const ImVec2& to   = after->position_;
+         ImVec2        actual(from.x + (to.x - from.x) * t,
+                       from.y + (to.y - from.y) * t);
+
+         float dx    = actual.x - prediction.position_.x;
+         float dy    = actual.y - prediction.position_.y;
+         float error = std::sqrt(dx * dx + dy * dy);
+
+         predictionError_ =
+            predictionCount_ == 0 ?
+               error :
+               predictionError_ +
+                  (error - predictionError_) * kPredictionErrorWeight_;
+         ++predictionCount_;
+      }
+
+      buffer.predictionPending_ = false;
+   }
+
+   const PointerPosition& last = history.back();
+
+   // Estimate the velocity over the recent positions
+   auto first = std::find_if(history.cbegin(),
+                             history.cend(),
+                             [&](const PointerPosition& position)
+                             {
+                                return last.time_ - position.time_ <=
+                                       kPredictionWindow_;
+                             });
+   float elapsed =
+      std::chrono::duration<float>(last.time_ - first->time_).count();
+
+   if (frameTime - last.time_ > kPredictionWindow_ || elapsed <= 0.0f)
+   {
+      // The pointer is at rest, replace any previous prediction with its
+      // actual position
+      if (buffer.positionPredicted_)
+      {
+         io_.AddMousePosEvent(last.position_.x, last.position_.y);
+         buffer.positionPredicted_ = false;
+      }
+      return;
+   }
+
+   ImVec2 velocity((last.position_.x - first->position_.x) / elapsed,
+                   (last.position_.y - first->position_.y) / elapsed);
+
+   // The frame is expected to be presented at the next refresh of the screen
+   qreal refreshRate = ImGui_ImplQt_GetScreen(object)->refreshRate();
+   if (refreshRate <= 0.0)
+   {
+      refreshRate = 60.0;
+   }
+
+   auto presentTime =
+      frameTime +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+         std::chrono::duration<qreal>(1.0 / refreshRate));
+   float horizon = std::min(
+      std::chrono::duration<float>(presentTime - last.time_).count(),
+      std::chrono::duration<float>(kMaxPredictionHorizon_).count());
+
+   // Time actually predicted, once the horizon is capped
+   auto predictedTime =
+      last.time_ +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+         std::chrono::duration<float>(horizon));
+
+   ImVec2 position(last.position_.x + velocity.x * horizon,
+                   last.position_.y + velocity.y * horizon);
+
+   // Clamp at the bounds of the object. With viewports, positions are global,
+   // and the pointer may be over any viewport of the desktop.
+   QRectF bounds(0.0, 0.0, io_.DisplaySize.x, io_.DisplaySize.y);
+   if (io_.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+   {
+      bounds = ImGui_ImplQt_GetScreen(object)->virtualGeometry();
+   }
+
+   position.x = std::clamp(position.x,
+                           static_cast<float>(bounds.left()),
+                           static_cast<float>(bounds.right()));
+   position.y = std::clamp(position.y,
+                           static_cast<float>(bounds.top()),
+                           static_cast<float>(bounds.bottom()));
+
+   io_.AddMousePosEvent(position.x, position.y);
+
+   prediction.time_          = predictedTime;
+   prediction.position_      = position;
+   buffer.predictionPending_ = true;
+   buffer.positionPredicted_ = true;
+}
+
+const std::vector<ImGui_ImplQt_PointerSample>&
+ImGuiQtBackend::PointerSamples() const
+{
+   static const std::vector<ImGui_ImplQt_PointerSample> kEmpty_ {};
+
+   auto it = pointerBuffers_.find(mainObject_);
+   return it != pointerBuffers_.cend() ? it->second.frame_ : kEmpty_;
 }
 
 void ImGuiQtBackend::MonitorCallback()
@@ -577,6 +1433,7 @@ void ImGui_ImplQt_Shutdown()
    IM_ASSERT(bd != nullptr &&
              "No platform backend to shutdown, or already shutdown?");
    bd->backend_->Shutdown();
+   bd->textureRegistry_.Clear();
    ImGuiIO& io = ImGui::GetIO();
 
    io.BackendPlatformName     = nullptr;
@@ -586,8 +1443,29 @@ void ImGui_ImplQt_Shutdown()
 
 void ImGuiQtBackend::Shutdown()
 {
-   ShutdownPlatformInterface();
-}
+   // Objects may still be registered, collect their settings and release their
+   // keys for objects created later
+   ImGuiQtSettingsStore* settingsStore = ImGuiQtSettingsStore::Instance();
+   for (auto& settingsKey : settingsKeys_)
+   {
+      SaveSettings(settingsKey.first);
+      if (settingsStore != nullptr)
+      {
+         settingsStore->ReleaseKey(settingsKey.second);
+      }
+   }
+   settingsKeys_.clear();
+
+   ShutdownPlatformInterface();
+
+   // Outstanding handles may outlive the backend
+   for (auto& eventChannel : eventChannels_)
+   {
+      eventChannel.second->closed_.store(true, std::memory_order_release);
+      eventChannel.second->object_ = nullptr;
+   }
+   eventChannels_.clear();
+}
 
 void ImGuiQtBackend::UpdateMouseData()
 {
@@ -603,97 +1481,225 @@ void ImGuiQtBackend::UpdateMouseCursor()
    ImGuiMouseCursor   imguiCursor = ImGui::GetMouseCursor();
    ImGui_ImplQt_Data* bd          = ImGui_ImplQt_GetBackendData();
 
+   // Hide mouse cursor if imgui is drawing it or if it wants no cursor
+   Qt::CursorShape cursorShape =
+      (imguiCursor == ImGuiMouseCursor_None || io.MouseDrawCursor) ?
+         Qt::BlankCursor :
+         ImGuiCursorToCursorShape(imguiCursor);
+
    for (QObject* object : bd->registeredObjects_)
    {
-      if (imguiCursor == ImGuiMouseCursor_None || io.MouseDrawCursor)
+      if (object->isWidgetType())
       {
-         // Hide mouse cursor if imgui is drawing it or if it wants no cursor
-         if (object->isWidgetType())
-         {
-            reinterpret_cast<QWidget*>(object)->setCursor(Qt::BlankCursor);
-         }
-         else if (object->isWindowType())
-         {
-            reinterpret_cast<QWindow*>(object)->setCursor(Qt::BlankCursor);
-         }
+         reinterpret_cast<QWidget*>(object)->setCursor(cursorShape);
+         continue;
       }
-      else
+
+      // Custom objects set their own cursor
+      auto it = cursorCallbacks_.find(object);
+      if (it != cursorCallbacks_.cend())
       {
-         // Show mouse cursor
-         if (object->isWidgetType())
-         {
-            reinterpret_cast<QWidget*>(object)->setCursor(
-               ImGuiCursorToCursorShape(imguiCursor));
-         }
-         else if (object->isWindowType())
-         {
-            reinterpret_cast<QWindow*>(object)->setCursor(
-               ImGuiCursorToCursorShape(imguiCursor));
-         }
+         it->second(QCursor(cursorShape));
+      }
+      else if (object->isWindowType())
+      {
+         reinterpret_cast<QWindow*>(object)->setCursor(cursorShape);
       }
    }
+
+#ifdef IMGUI_HAS_DOCK
+   // Viewport windows follow the cursor of the context
+   for (auto& viewportWindow : viewportWindows_)
+   {
+      reinterpret_cast<QWindow*>(viewportWindow.first)->setCursor(cursorShape);
+   }
+#endif
 }
 
 void ImGuiQtBackend::UpdateMonitors()
 {
-   // Stub for multi-viewport
+#ifdef IMGUI_HAS_DOCK
+   ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+   QScreen*         primary    = QGuiApplication::primaryScreen();
+
+   platformIo.Monitors.resize(0);
+
+   for (QScreen* screen : QGuiApplication::screens())
+   {
+      QRect geometry          = screen->geometry();
+      QRect availableGeometry = screen->availableGeometry();
+
+      ImGuiPlatformMonitor monitor;
+      monitor.MainPos  = ImVec2(static_cast<float>(geometry.x()),
+                               static_cast<float>(geometry.y()));
+      monitor.MainSize = ImVec2(static_cast<float>(geometry.width()),
+                                static_cast<float>(geometry.height()));
+      monitor.WorkPos  = ImVec2(static_cast<float>(availableGeometry.x()),
+                               static_cast<float>(availableGeometry.y()));
+      monitor.WorkSize = ImVec2(static_cast<float>(availableGeometry.width()),
+                                static_cast<float>(availableGeometry.height()));
+      monitor.DpiScale = static_cast<float>(screen->devicePixelRatio());
+      monitor.PlatformHandle = static_cast<void*>(screen);
+
+      // The primary monitor is expected first
+      if (screen == primary)
+      {
+         platformIo.Monitors.push_front(monitor);
+      }
+      else
+      {
+         platformIo.Monitors.push_back(monitor);
+      }
+   }
+#endif
+
+   wantUpdateMonitors_ = false;
 }
 
 bool ImGuiQtBackend::eventFilter(QObject* watched, QEvent* event)
 {
-   bool widgetNeedsUpdate = false;
+   // Fast path for the majority of events, which are not processed. Like
+   // QObject::eventFilter(), these are never filtered. Benchmarks disable it
+   // to measure the dispatch of every event.
+#ifndef IMGUI_IMPL_QT_DISABLE_EVENT_MASK
+   if (!kFilteredEvents_.Contains(event->type()))
+   {
+      return false;
+   }
+#endif
+
+   bool     widgetNeedsUpdate = false;
+   bool     inputConsumed     = false;
+   QObject* target            = watched;
+
+#ifdef IMGUI_HAS_DOCK
+   auto viewportIt = viewportWindows_.find(watched);
+   if (viewportIt != viewportWindows_.cend())
+   {
+      if (HandleViewportEvent(viewportIt->second, event))
+      {
+         return true;
+      }
+
+      if (mainObject_ == nullptr)
+      {
+         return QObject::eventFilter(watched, event);
+      }
+
+      // Input to viewport windows is processed in the frame of the main object
+      target = mainObject_;
+   }
+   else if (std::find(windowPool_.cbegin(), windowPool_.cend(), watched) !=
+            windowPool_.cend())
+   {
+      // Pooled windows may still receive input, e.g. the release ending a drag
+      // which started in the destroyed viewport
+      if (mainObject_ == nullptr)
+      {
+         return QObject::eventFilter(watched, event);
+      }
+
+      target = mainObject_;
+   }
+#endif
+
+   // Event queues and pointer buffers only exist for registered objects
+   if (eventQueue_.find(target) == eventQueue_.cend())
+   {
+      return QObject::eventFilter(watched, event);
+   }
 
    switch (event->type())
    {
    case QEvent::Enter:
       // Mouse enters widget's boundaries
-      HandleEnter(watched, reinterpret_cast<QEnterEvent*>(event));
+      HandleEnter(target, reinterpret_cast<QEnterEvent*>(event));
       widgetNeedsUpdate = true;
       break;
 
    case QEvent::Leave:
       // Mouse leaves widget's boundaries
-      HandleLeave(watched, event);
+      HandleLeave(target, event);
       widgetNeedsUpdate = true;
       break;
 
    case QEvent::FocusIn:
    case QEvent::FocusOut:
       // Widget or Window gains/loses keyboard focus
-      HandleFocus(watched, reinterpret_cast<QFocusEvent*>(event));
+      HandleFocus(target, reinterpret_cast<QFocusEvent*>(event));
       widgetNeedsUpdate = true;
       break;
 
    case QEvent::KeyPress:
    case QEvent::KeyRelease:
       // Key press/release
-      HandleKeyPress(watched, reinterpret_cast<QKeyEvent*>(event));
+      HandleKeyPress(target, reinterpret_cast<QKeyEvent*>(event));
       widgetNeedsUpdate = true;
       break;
 
    case QEvent::MouseButtonPress:
    case QEvent::MouseButtonRelease:
       // Mouse press/release
-      HandleMouseButtonPress(watched, reinterpret_cast<QMouseEvent*>(event));
+      HandleMouseButtonPress(target, reinterpret_cast<QMouseEvent*>(event));
       widgetNeedsUpdate = true;
       break;
 
    case QEvent::MouseMove:
       // Mouse move
-      HandleMouseMove(watched, reinterpret_cast<QMouseEvent*>(event));
+      HandleMouseMove(target, reinterpret_cast<QMouseEvent*>(event));
+      widgetNeedsUpdate = true;
+      break;
+
+   case QEvent::HoverEnter:
+   case QEvent::HoverMove:
+      // Mouse hovers item (Qt Quick items don't receive mouse move events
+      // without a button pressed)
+      HandleMouseMove(target, reinterpret_cast<QHoverEvent*>(event));
+      widgetNeedsUpdate = true;
+      break;
+
+   case QEvent::HoverLeave:
+      // Mouse leaves item's boundaries
+      HandleLeave(target, event);
       widgetNeedsUpdate = true;
       break;
 
    case QEvent::Wheel:
       // Mouse wheel moved
-      HandleWheel(watched, reinterpret_cast<QWheelEvent*>(event));
+      HandleWheel(target, reinterpret_cast<QWheelEvent*>(event));
+      widgetNeedsUpdate = true;
+      break;
+
+   case QEvent::TabletPress:
+   case QEvent::TabletMove:
+   case QEvent::TabletRelease:
+      // Pen press/move/release
+      HandleTablet(target, reinterpret_cast<QTabletEvent*>(event));
+      widgetNeedsUpdate = true;
+      inputConsumed     = true;
+      break;
+
+   case QEvent::TouchBegin:
+   case QEvent::TouchUpdate:
+   case QEvent::TouchEnd:
+   case QEvent::TouchCancel:
+      // Touch points changed
+      HandleTouch(target, reinterpret_cast<QTouchEvent*>(event));
       widgetNeedsUpdate = true;
+      inputConsumed     = true;
       break;
    }
 
-   if (widgetNeedsUpdate && watched->isWidgetType())
+   if (widgetNeedsUpdate)
    {
-      reinterpret_cast<QWidget*>(watched)->update();
+      RequestUpdate(target);
+   }
+
+   if (inputConsumed)
+   {
+      // Accept and filter, so Qt does not synthesize mouse events as well
+      event->accept();
+      return true;
    }
 
    return QObject::eventFilter(watched, event);
@@ -703,6 +1709,190 @@ void ImGuiQtBackend::RegisterObject(QObject* object)
 {
    // Make sure an entry exists in the event queue for this object
    eventQueue_[object];
+   pointerBuffers_[object];
+
+   ImGui_ImplQt_EventHandle& channel = eventChannels_[object];
+   if (channel == nullptr)
+   {
+      channel           = std::make_shared<ImGui_ImplQt_EventChannel>();
+      channel->object_  = object;
+      channel->backend_ = this;
+   }
+
+   ImGuiQtSettingsStore* settingsStore = ImGuiQtSettingsStore::Instance();
+   if (settingsStore != nullptr && settingsKeys_.count(object) == 0)
+   {
+      // Settings are managed by the backend, instead of per-context files
+      io_.IniFilename = nullptr;
+
+      std::string        key      = settingsStore->AssignKey(object);
+      const std::string& settings = settingsStore->Get(key);
+      if (!settings.empty())
+      {
+         ImGui::LoadIniSettingsFromMemory(settings.c_str(), settings.size());
+      }
+
+      settingsKeys_.emplace(object, std::move(key));
+   }
+}
+
+void ImGuiQtBackend::SaveSettings(QObject* object)
+{
+   ImGuiQtSettingsStore* settingsStore = ImGuiQtSettingsStore::Instance();
+   auto                  it            = settingsKeys_.find(object);
+
+   if (settingsStore != nullptr && it != settingsKeys_.cend())
+   {
+      settingsStore->Set(it->second, ImGui::SaveIniSettingsToMemory());
+      io_.WantSaveIniSettings = false;
+   }
+}
+
+void ImGuiQtBackend::UnregisterObject(QObject* object)
+{
+   // Collect settings which may not have been saved yet
+   SaveSettings(object);
+
+   auto settingsKeyIt = settingsKeys_.find(object);
+   if (settingsKeyIt != settingsKeys_.end())
+   {
+      ImGuiQtSettingsStore* settingsStore = ImGuiQtSettingsStore::Instance();
+      if (settingsStore != nullptr)
+      {
+         settingsStore->ReleaseKey(settingsKeyIt->second);
+      }
+      settingsKeys_.erase(settingsKeyIt);
+   }
+
+   // Forget any references to the object
+   if (mainObject_ == object)
+   {
+      mainObject_ = nullptr;
+   }
+   if (focusedObject_ == object)
+   {
+      focusedObject_ = nullptr;
+   }
+   if (keyboardObject_ == object)
+   {
+      keyboardObject_ = nullptr;
+   }
+   if (mouseObject_ == object)
+   {
+      mouseObject_ = nullptr;
+   }
+
+   eventQueue_.erase(object);
+   pointerBuffers_.erase(object);
+   updateCallbacks_.erase(object);
+   cursorCallbacks_.erase(object);
+
+   // Outstanding handles may outlive the object
+   auto channelIt = eventChannels_.find(object);
+   if (channelIt != eventChannels_.end())
+   {
+      channelIt->second->closed_.store(true, std::memory_order_release);
+      channelIt->second->object_ = nullptr;
+      eventChannels_.erase(channelIt);
+   }
+}
+
+void ImGuiQtBackend::SetUpdateCallback(QObject*              object,
+                                       std::function<void()> callback)
+{
+   updateCallbacks_[object] = std::move(callback);
+}
+
+void ImGuiQtBackend::SetCursorCallback(
+   QObject* object, std::function<void(const QCursor&)> callback)
+{
+   if (callback)
+   {
+      cursorCallbacks_[object] = std::move(callback);
+   }
+}
+
+void ImGuiQtBackend::RequestUpdate(QObject* object)
+{
+   if (object->isWidgetType())
+   {
+      reinterpret_cast<QWidget*>(object)->update();
+      return;
+   }
+
+   auto it = updateCallbacks_.find(object);
+   if (it != updateCallbacks_.cend())
+   {
+      it->second();
+   }
+   else if (object->isWindowType())
+   {
+      reinterpret_cast<QWindow*>(object)->requestUpdate();
+   }
+}
+
+void ImGuiQtBackend::SetPointerPrediction(bool enabled)
+{
+   pointerPrediction_ = enabled;
+
+   if (!enabled)
+   {
+      for (auto& it : pointerBuffers_)
+      {
+         PointerBuffer& buffer = it.second;
+
+         // Replace a predicted position with the actual position
+         if (buffer.positionPredicted_ && !buffer.history_.empty())
+         {
+            ImVec2 position = buffer.history_.back().position_;
+            QueueEvent(
+               it.first,
+               [=]() { io_.AddMousePosEvent(position.x, position.y); },
+               true);
+         }
+
+         buffer.history_.clear();
+         buffer.predictionPending_ = false;
+         buffer.positionPredicted_ = false;
+      }
+   }
+}
+
+ImGui_ImplQt_BackendStats ImGuiQtBackend::Stats() const
+{
+   ImGui_ImplQt_BackendStats stats {};
+
+   stats.RegisteredObjects = static_cast<int>(eventQueue_.size());
+   stats.QueueCapacity     = kMaxQueuedEvents_;
+   stats.DroppedEvents     = droppedEvents_;
+   stats.NewFrameTime      = newFrameTime_;
+   stats.PredictionError   = predictionError_;
+
+   for (auto& queue : eventQueue_)
+   {
+      stats.QueuedEvents += queue.second.size();
+      stats.MaxQueuedEvents =
+         std::max(stats.MaxQueuedEvents, queue.second.size());
+   }
+
+   for (auto& pointerBuffer : pointerBuffers_)
+   {
+      stats.PendingPointerSamples += pointerBuffer.second.pending_.size();
+   }
+
+   for (auto& eventChannel : eventChannels_)
+   {
+      stats.PendingPostedEvents += static_cast<std::size_t>(
+         eventChannel.second->size_.load(std::memory_order_relaxed));
+   }
+
+   return stats;
+}
+
+ImGui_ImplQt_EventHandle ImGuiQtBackend::EventHandle(QObject* object) const
+{
+   auto it = eventChannels_.find(object);
+   return it != eventChannels_.cend() ? it->second : nullptr;
 }
 
 template<class T>
@@ -718,12 +1908,18 @@ static void ImGui_ImplQt_RegisterObject(T* object)
    object->installEventFilter(bd->backend_.get());
 
    // Add to list of registered objects
-   bd->registeredObjects_.push_back(object);
+   if (std::find(bd->registeredObjects_.cbegin(),
+                 bd->registeredObjects_.cend(),
+                 object) == bd->registeredObjects_.cend())
+   {
+      bd->registeredObjects_.push_back(object);
+   }
 }
 
 void ImGui_ImplQt_RegisterWidget(QWidget* widget)
 {
    widget->setMouseTracking(true);
+   widget->setAttribute(Qt::WidgetAttribute::WA_AcceptTouchEvents);
    ImGui_ImplQt_RegisterObject(widget);
 }
 
@@ -745,6 +1941,9 @@ static void ImGui_ImplQt_UnregisterObject(T* object)
    // Uninstall widget callbacks
    object->removeEventFilter(bd->backend_.get());
 
+   // Unregister the object with the backend
+   bd->backend_->UnregisterObject(object);
+
    // Remove from list of registered objects
    auto it = std::find(
       bd->registeredObjects_.begin(), bd->registeredObjects_.end(), object);
@@ -780,60 +1979,1262 @@ void ImGui_ImplQt_NewFrame(QWindow* window)
    bd->backend_->NewFrame(window);
 }
 
-template<class T>
-void ImGuiQtBackend::NewFrame(T* object)
+ImGui_ImplQt_EventHandle ImGui_ImplQt_GetEventHandle(QWidget* widget)
 {
-   // Setup display size (every frame to accommodate for window resizing)
-   QSize widgetSize            = object->size();
-   float pixelRatio            = static_cast<float>(object->devicePixelRatio());
-   io_.DisplaySize             = ImVec2(static_cast<float>(widgetSize.width()),
-                            static_cast<float>(widgetSize.height()));
-   io_.DisplayFramebufferScale = ImVec2(pixelRatio, pixelRatio);
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
 
-   if (wantUpdateMonitors_)
+   return bd->backend_->EventHandle(widget);
+}
+
+ImGui_ImplQt_EventHandle ImGui_ImplQt_GetEventHandle(QWindow* window)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->backend_->EventHandle(window);
+}
+
+ImGui_ImplQt_EventHandle ImGui_ImplQt_GetEventHandle(QObject* object)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->backend_->EventHandle(object);
+}
+
+bool ImGui_ImplQt_PostEvent(const ImGui_ImplQt_EventHandle& handle,
+                            std::function<void(ImGuiIO& io)> event)
+{
+   if (handle == nullptr || handle->closed_.load(std::memory_order_acquire))
    {
-      UpdateMonitors();
+      return false;
    }
 
-   // Setup time step
-   auto currentTime = std::chrono::steady_clock::now();
-   io_.DeltaTime =
-      time_ > std::chrono::steady_clock::time_point {} ?
-         std::chrono::duration<float>(currentTime - time_).count() :
-         (float) (1.0f / 60.0f);
-   time_ = currentTime;
+   // Bound the queue of objects which are not being rendered
+   if (handle->size_.fetch_add(1, std::memory_order_relaxed) >=
+       kMaxPostedEvents_)
+   {
+      handle->size_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+   }
 
-   // If there are events in the queue, trigger an additional update
-   if (!eventQueue_.at(object).empty() && object->isWidgetType())
+   ImGui_ImplQt_EventChannel::Node* node =
+      new ImGui_ImplQt_EventChannel::Node();
+   node->event_ = std::move(event);
+   handle->Push(node);
+
+   ImGui_ImplQt_RequestFrame(handle);
+
+   return true;
+}
+
+void ImGui_ImplQt_RequestFrame(const ImGui_ImplQt_EventHandle& handle)
+{
+   if (handle == nullptr || handle->closed_.load(std::memory_order_acquire))
    {
-      reinterpret_cast<QWidget*>(object)->update();
+      return;
    }
 
-   // Process events
-   while (!eventQueue_.at(object).empty())
+   // Only the first request of a frame queues a wake-up. Posting it locks
+   // the event queue of the GUI thread.
+   if (!handle->frameRequested_.exchange(true, std::memory_order_acq_rel))
    {
-      eventQueue_.at(object).front()();
-      eventQueue_.at(object).pop_front();
+      // The application object outlives any registered object, and the channel
+      // is kept alive until the wake-up runs on the GUI thread
+      ImGui_ImplQt_EventHandle channel = handle;
+      QMetaObject::invokeMethod(
+         QCoreApplication::instance(),
+         [channel]() { channel->Wake(); },
+         Qt::ConnectionType::QueuedConnection);
    }
+}
 
-   UpdateMouseData();
-   UpdateMouseCursor();
+ImGui_ImplQt_EventChannel::~ImGui_ImplQt_EventChannel()
+{
+   while (Node* node = Pop())
+   {
+      delete node;
+   }
 }
 
-//--------------------------------------------------------------------------------------------------------
-// MULTI-VIEWPORT / PLATFORM INTERFACE SUPPORT
-// This is an _advanced_ and _optional_ feature, allowing the backend to create
-// and handle multiple viewports simultaneously. If you are new to dear imgui or
-// creating a new binding for dear imgui, it is recommended that you completely
-// ignore this section first..
-//--------------------------------------------------------------------------------------------------------
+void ImGui_ImplQt_EventChannel::Push(Node* node)
+{
+   node->next_.store(nullptr, std::memory_order_relaxed);
+   Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+   previous->next_.store(node, std::memory_order_release);
+}
 
-void ImGuiQtBackend::InitPlatformInterface()
+ImGui_ImplQt_EventChannel::Node* ImGui_ImplQt_EventChannel::Pop()
+{
+   Node* tail = tail_;
+   Node* next = tail->next_.load(std::memory_order_acquire);
+
+   if (tail == &stub_)
+   {
+      if (next == nullptr)
+      {
+         return nullptr;
+      }
+
+      // Skip the stub node
+      tail_ = next;
+      tail  = next;
+      next  = next->next_.load(std::memory_order_acquire);
+   }
+
+   if (next != nullptr)
+   {
+      tail_ = next;
+      return tail;
+   }
+
+   if (tail != head_.load(std::memory_order_acquire))
+   {
+      // A producer is between exchanging the head and linking its node, the
+      // node will be consumed in the next frame
+      return nullptr;
+   }
+
+   // Re-insert the stub node, so the last node can be returned
+   Push(&stub_);
+
+   next = tail->next_.load(std::memory_order_acquire);
+   if (next != nullptr)
+   {
+      tail_ = next;
+      return tail;
+   }
+
+   return nullptr;
+}
+
+void ImGui_ImplQt_EventChannel::Wake()
 {
-   // Stub for multi-viewport
+   // Unregistered objects have no object
+   if (object_ != nullptr)
+   {
+      backend_->RequestUpdate(object_);
+   }
 }
 
-void ImGuiQtBackend::ShutdownPlatformInterface()
+void ImGui_ImplQt_RegisterCustomObject(
+   QObject*                            object,
+   std::function<void()>               requestUpdate,
+   std::function<void(const QCursor&)> setCursor)
+{
+   ImGui_ImplQt_RegisterObject(object);
+
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   bd->backend_->SetUpdateCallback(object, std::move(requestUpdate));
+   bd->backend_->SetCursorCallback(object, std::move(setCursor));
+}
+
+void ImGui_ImplQt_UnregisterCustomObject(QObject* object)
+{
+   ImGui_ImplQt_UnregisterObject(object);
+}
+
+void ImGui_ImplQt_NewFrame(QObject* object,
+                           ImVec2   displaySize,
+                           float    framebufferScale)
 {
-   // Stub for multi-viewport
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   bd->backend_->NewFrame(object, displaySize, framebufferScale);
+}
+
+ImGui_ImplQt_BackendStats ImGui_ImplQt_GetBackendStats()
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->backend_->Stats();
+}
+
+const ImGui_ImplQt_PointerSample* ImGui_ImplQt_GetPointerSamples(int* count)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   const std::vector<ImGui_ImplQt_PointerSample>& samples =
+      bd->backend_->PointerSamples();
+
+   if (count != nullptr)
+   {
+      *count = static_cast<int>(samples.size());
+   }
+
+   return samples.data();
+}
+
+void ImGui_ImplQt_SetPointerPrediction(bool enabled)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   bd->backend_->SetPointerPrediction(enabled);
+}
+
+template<class T>
+void ImGuiQtBackend::NewFrame(T* object)
+{
+   // Setup display size (every frame to accommodate for window resizing)
+   QSize widgetSize = object->size();
+   float pixelRatio = static_cast<float>(object->devicePixelRatio());
+   NewFrame(object,
+            ImVec2(static_cast<float>(widgetSize.width()),
+                   static_cast<float>(widgetSize.height())),
+            pixelRatio);
+}
+
+void ImGuiQtBackend::NewFrame(QObject* object,
+                              ImVec2   displaySize,
+                              float    framebufferScale)
+{
+   io_.DisplaySize             = displaySize;
+   io_.DisplayFramebufferScale = ImVec2(framebufferScale, framebufferScale);
+
+   if (wantUpdateMonitors_)
+   {
+      UpdateMonitors();
+   }
+
+   mainObject_ = object;
+   ++frameCount_;
+
+#ifdef IMGUI_HAS_DOCK
+   // The main viewport follows the object being rendered
+   ImGuiViewport*             mainViewport = ImGui::GetMainViewport();
+   ImGui_ImplQt_ViewportData* vd           = static_cast<
+      ImGui_ImplQt_ViewportData*>(mainViewport->PlatformUserData);
+   if (vd != nullptr)
+   {
+      vd->object_                  = object;
+      mainViewport->PlatformHandle = static_cast<void*>(object);
+   }
+#endif
+
+   // Setup time step
+   auto currentTime = std::chrono::steady_clock::now();
+   io_.DeltaTime =
+      time_ > std::chrono::steady_clock::time_point {} ?
+         std::chrono::duration<float>(currentTime - time_).count() :
+         (float) (1.0f / 60.0f);
+   time_ = currentTime;
+
+   // If there are events in the queue, trigger an additional update
+   if (!eventQueue_.at(object).empty())
+   {
+      RequestUpdate(object);
+   }
+
+   // Process events
+   while (!eventQueue_.at(object).empty())
+   {
+      eventQueue_.at(object).front().event_();
+      eventQueue_.at(object).pop_front();
+   }
+
+   // Process events posted from other threads. Frame requests made from now on
+   // require another frame.
+   ImGui_ImplQt_EventChannel* channel = eventChannels_.at(object).get();
+   channel->frameRequested_.store(false, std::memory_order_release);
+
+   while (ImGui_ImplQt_EventChannel::Node* node = channel->Pop())
+   {
+      channel->size_.fetch_sub(1, std::memory_order_relaxed);
+      node->event_(io_);
+      delete node;
+   }
+
+   // Tablet and touch samples since the last frame are readable by this frame
+   PointerBuffer& pointerBuffer = pointerBuffers_.at(object);
+   std::swap(pointerBuffer.frame_, pointerBuffer.pending_);
+   pointerBuffer.pending_.clear();
+   pointerBuffer.queuedMove_.reset();
+
+   if (pointerPrediction_ && mouseObject_ == object)
+   {
+      PredictPointerPosition(object, currentTime);
+   }
+
+   // Collect settings, once ImGui requests them to be saved
+   if (io_.WantSaveIniSettings)
+   {
+      SaveSettings(object);
+   }
+
+   UpdateMouseData();
+   UpdateMouseCursor();
+
+   newFrameTime_ = std::chrono::duration<float>(
+                      std::chrono::steady_clock::now() - currentTime)
+                      .count();
+}
+
+//--------------------------------------------------------------------------------------------------------
+// TEXTURE REGISTRY
+// Maps QImage/QPixmap contents to renderer textures through the application
+// provided ImGui_ImplQt_TextureCallbacks. Textures are identified by the serial
+// number part of cacheKey(), and re-uploaded when the detach number changes.
+//--------------------------------------------------------------------------------------------------------
+
+static qint64 ImGui_ImplQt_TextureKey(qint64 cacheKey, bool pixmap)
+{
+   // Serial number is stored in the upper 32 bits of the cache key
+   return ((cacheKey >> 32) << 1) | (pixmap ? 1 : 0);
+}
+
+ImTextureID ImGuiQtTextureRegistry::GetTexture(const QImage&  image,
+                                               const QRegion* dirtyRegion)
+{
+   return GetTexture(
+      ImGui_ImplQt_TextureKey(image.cacheKey(), false), image, dirtyRegion);
+}
+
+ImTextureID ImGuiQtTextureRegistry::GetTexture(const QPixmap& pixmap,
+                                               const QRegion* dirtyRegion)
+{
+   return GetTexture(
+      ImGui_ImplQt_TextureKey(pixmap.cacheKey(), true), pixmap, dirtyRegion);
+}
+
+template<class T>
+ImTextureID ImGuiQtTextureRegistry::GetTexture(qint64         key,
+                                               const T&       source,
+                                               const QRegion* dirtyRegion)
+{
+   IM_ASSERT(callbacks_.CreateTexture != nullptr &&
+             "Did you call ImGui_ImplQt_SetTextureCallbacks()?");
+
+   if (source.isNull())
+   {
+      return ImTextureID {};
+   }
+
+   Entry* entry;
+   auto   it = lookup_.find(key);
+   if (it != lookup_.end())
+   {
+      // Mark as most recently used
+      entries_.splice(entries_.begin(), entries_, it->second);
+      entry = &*it->second;
+
+      if (entry->cacheKey_ == source.cacheKey())
+      {
+         ++stats_.Hits;
+         entry->lastUsedFrame_ = ImGui::GetFrameCount();
+         return entry->textureId_;
+      }
+
+      ++stats_.Updates;
+   }
+   else
+   {
+      entries_.emplace_front();
+      entry       = &entries_.front();
+      entry->key_ = key;
+      lookup_.emplace(key, entries_.begin());
+
+      ++stats_.Misses;
+      ++stats_.ResidentTextures;
+   }
+
+   entry->cacheKey_      = source.cacheKey();
+   entry->lastUsedFrame_ = ImGui::GetFrameCount();
+
+   // QPixmap contents are only read back when an upload is required
+   Upload(*entry, source, dirtyRegion);
+
+   ImTextureID textureId = entry->textureId_;
+   Evict();
+
+   return textureId;
+}
+
+void ImGuiQtTextureRegistry::Upload(Entry&         entry,
+                                    const QImage&  image,
+                                    const QRegion* dirtyRegion)
+{
+   QRegion region;
+   if (!UpdateRegion(entry, image.size(), dirtyRegion, region))
+   {
+      Create(entry, image);
+      return;
+   }
+
+   // Images already in the texture format are uploaded without a copy
+   const bool inPlace = image.format() == QImage::Format_RGBA8888;
+
+   for (const QRect& rect : region)
+   {
+      if (inPlace)
+      {
+         UpdateRect(entry,
+                    rect,
+                    image.constScanLine(rect.y()) + rect.x() * 4,
+                    image.bytesPerLine());
+      }
+      else
+      {
+         // Only convert the dirty part of the image
+         const QImage rgbaImage =
+            image.copy(rect).convertToFormat(QImage::Format_RGBA8888);
+
+         UpdateRect(
+            entry, rect, rgbaImage.constBits(), rgbaImage.bytesPerLine());
+      }
+   }
+}
+
+void ImGuiQtTextureRegistry::Upload(Entry&         entry,
+                                    const QPixmap& pixmap,
+                                    const QRegion* dirtyRegion)
+{
+   QRegion region;
+   if (!UpdateRegion(entry, pixmap.size(), dirtyRegion, region))
+   {
+      Create(entry, pixmap.toImage());
+      return;
+   }
+
+   const QRect pixmapRect {QPoint(), pixmap.size()};
+
+   for (const QRect& rect : region)
+   {
+      // Only read back and convert the dirty part of the pixmap
+      const QImage rgbaImage =
+         (rect == pixmapRect ? pixmap : pixmap.copy(rect))
+            .toImage()
+            .convertToFormat(QImage::Format_RGBA8888);
+
+      UpdateRect(
+         entry, rect, rgbaImage.constBits(), rgbaImage.bytesPerLine());
+   }
+}
+
+bool ImGuiQtTextureRegistry::UpdateRegion(const Entry&   entry,
+                                          QSize          size,
+                                          const QRegion* dirtyRegion,
+                                          QRegion&       region) const
+{
+   if (entry.textureId_ == ImTextureID {} || entry.size_ != size)
+   {
+      // New texture, or the size changed: (re)create the full texture
+      return false;
+   }
+
+   const QRect imageRect {QPoint(), size};
+   region = dirtyRegion != nullptr ? dirtyRegion->intersected(imageRect) :
+                                     QRegion(imageRect);
+
+   const std::size_t area =
+      static_cast<std::size_t>(size.width()) * size.height();
+   std::size_t dirtyArea = 0;
+   for (const QRect& rect : region)
+   {
+      dirtyArea += static_cast<std::size_t>(rect.width()) * rect.height();
+   }
+   if (dirtyArea * 2u > area)
+   {
+      // Beyond half of the image, a single full upload is cheaper
+      region = QRegion(imageRect);
+   }
+
+   return true;
+}
+
+void ImGuiQtTextureRegistry::Create(Entry& entry, const QImage& image)
+{
+   Destroy(entry);
+
+   const QImage rgbaImage = image.format() == QImage::Format_RGBA8888 ?
+                               image :
+                               image.convertToFormat(QImage::Format_RGBA8888);
+   const std::size_t area =
+      static_cast<std::size_t>(image.width()) * image.height();
+
+   entry.size_      = image.size();
+   entry.textureId_ = callbacks_.CreateTexture(rgbaImage.width(),
+                                               rgbaImage.height(),
+                                               rgbaImage.constBits(),
+                                               rgbaImage.bytesPerLine(),
+                                               callbacks_.UserData);
+
+   stats_.UploadedBytes += area * 4u;
+   stats_.ResidentBytes += area * 4u;
+}
+
+void ImGuiQtTextureRegistry::UpdateRect(Entry&       entry,
+                                        const QRect& rect,
+                                        const void*  pixels,
+                                        int          stride)
+{
+   callbacks_.UpdateTexture(entry.textureId_,
+                            rect.x(),
+                            rect.y(),
+                            rect.width(),
+                            rect.height(),
+                            pixels,
+                            stride,
+                            callbacks_.UserData);
+
+   stats_.UploadedBytes +=
+      static_cast<std::size_t>(rect.width()) * rect.height() * 4u;
+}
+
+void ImGuiQtTextureRegistry::Destroy(Entry& entry)
+{
+   if (entry.textureId_ == ImTextureID {})
+   {
+      return;
+   }
+
+   if (callbacks_.DestroyTexture != nullptr)
+   {
+      callbacks_.DestroyTexture(entry.textureId_, callbacks_.UserData);
+   }
+
+   stats_.ResidentBytes -=
+      static_cast<std::size_t>(entry.size_.width()) * entry.size_.height() * 4u;
+   entry.textureId_ = ImTextureID {};
+}
+
+void ImGuiQtTextureRegistry::Evict()
+{
+   const int frameCount = ImGui::GetFrameCount();
+
+   // Textures used in the current frame may still be referenced by draw lists
+   while (stats_.ResidentBytes > budget_ && !entries_.empty() &&
+          entries_.back().lastUsedFrame_ != frameCount)
+   {
+      Destroy(entries_.back());
+      lookup_.erase(entries_.back().key_);
+      entries_.pop_back();
+
+      ++stats_.Evictions;
+      --stats_.ResidentTextures;
+   }
+}
+
+void ImGuiQtTextureRegistry::Clear()
+{
+   for (Entry& entry : entries_)
+   {
+      Destroy(entry);
+   }
+
+   entries_.clear();
+   lookup_.clear();
+   stats_.ResidentTextures = 0;
+}
+
+void ImGui_ImplQt_SetTextureCallbacks(
+   const ImGui_ImplQt_TextureCallbacks& callbacks)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   // Textures created with previous callbacks can no longer be managed
+   bd->textureRegistry_.Clear();
+   bd->textureRegistry_.callbacks_ = callbacks;
+}
+
+void ImGui_ImplQt_SetTextureMemoryBudget(size_t bytes)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   bd->textureRegistry_.budget_ = bytes;
+}
+
+ImGui_ImplQt_TextureStats ImGui_ImplQt_GetTextureStats()
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->textureRegistry_.stats_;
+}
+
+ImTextureID ImGui_ImplQt_GetTexture(const QImage& image)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->textureRegistry_.GetTexture(image, nullptr);
+}
+
+ImTextureID ImGui_ImplQt_GetTexture(const QImage&  image,
+                                    const QRegion& dirtyRegion)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->textureRegistry_.GetTexture(image, &dirtyRegion);
+}
+
+ImTextureID ImGui_ImplQt_GetTexture(const QPixmap& pixmap)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->textureRegistry_.GetTexture(pixmap, nullptr);
+}
+
+ImTextureID ImGui_ImplQt_GetTexture(const QPixmap& pixmap,
+                                    const QRegion& dirtyRegion)
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplQt_Init()?");
+
+   return bd->textureRegistry_.GetTexture(pixmap, &dirtyRegion);
+}
+
+//--------------------------------------------------------------------------------------------------------
+// SETTINGS PERSISTENCE
+// Instead of one imgui.ini per context, read and written synchronously by each
+// context, the settings of all registered objects are stored in a single JSON
+// file. Each object is keyed by its objectName(), or by its class name and
+// registration order when unnamed.
+//--------------------------------------------------------------------------------------------------------
+
+// Settings are written once unchanged for this interval, or at the latest this
+// long after the first unwritten change
+static constexpr int kSettingsWriteDelayMs_    = 1000;
+static constexpr int kSettingsMaxWriteDelayMs_ = 5000;
+
+static ImGuiQtSettingsStore* settingsStore_ = nullptr;
+
+ImGuiQtSettingsStore::ImGuiQtSettingsStore(const QString& filename) :
+    QObject(QCoreApplication::instance()), filename_ {filename}
+{
+   // Writes are serialized, in order
+   writePool_.setMaxThreadCount(1);
+
+   writeTimer_.setSingleShot(true);
+   QObject::connect(
+      &writeTimer_, &QTimer::timeout, this, &ImGuiQtSettingsStore::Write);
+
+   Load();
+}
+
+ImGuiQtSettingsStore::~ImGuiQtSettingsStore()
+{
+   // Flush pending changes
+   if (writeTimer_.isActive())
+   {
+      writeTimer_.stop();
+      Write();
+   }
+   writePool_.waitForDone();
+
+   if (settingsStore_ == this)
+   {
+      settingsStore_ = nullptr;
+   }
+}
+
+ImGuiQtSettingsStore* ImGuiQtSettingsStore::Instance()
+{
+   return settingsStore_;
+}
+
+void ImGuiQtSettingsStore::SetFilename(const QString& filename)
+{
+   delete settingsStore_;
+   settingsStore_ =
+      filename.isEmpty() ? nullptr : new ImGuiQtSettingsStore(filename);
+}
+
+std::string ImGuiQtSettingsStore::AssignKey(QObject* object)
+{
+   if (!object->objectName().isEmpty())
+   {
+      return object->objectName().toStdString();
+   }
+
+   // Unnamed objects use the lowest free index of their class, so the keys of
+   // destroyed objects are reused instead of accumulating in the store
+   std::string className = object->metaObject()->className();
+   std::string key;
+
+   for (int index = 0;; ++index)
+   {
+      key = className + "#" + std::to_string(index);
+      if (assignedKeys_.insert(key).second)
+      {
+         break;
+      }
+   }
+
+   return key;
+}
+
+void ImGuiQtSettingsStore::ReleaseKey(const std::string& key)
+{
+   assignedKeys_.erase(key);
+}
+
+const std::string& ImGuiQtSettingsStore::Get(const std::string& key) const
+{
+   static const std::string kEmpty_ {};
+
+   auto it = settings_.find(key);
+   return it != settings_.cend() ? it->second : kEmpty_;
+}
+
+void ImGuiQtSettingsStore::Set(const std::string& key, std::string settings)
+{
+   std::string& storedSettings = settings_[key];
+   if (storedSettings == settings)
+   {
+      return;
+   }
+
+   storedSettings = std::move(settings);
+
+   // Restart the delay on each change, within the maximum delay
+   if (!writeTimer_.isActive())
+   {
+      pendingTimer_.start();
+   }
+   writeTimer_.start(static_cast<int>(
+      std::clamp<qint64>(kSettingsMaxWriteDelayMs_ - pendingTimer_.elapsed(),
+                         0,
+                         kSettingsWriteDelayMs_)));
+}
+
+void ImGuiQtSettingsStore::Load()
+{
+   QFile file(filename_);
+   if (!file.open(QIODevice::OpenModeFlag::ReadOnly))
+   {
+      // No settings saved yet
+      return;
+   }
+
+   QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+   for (auto it = root.constBegin(); it != root.constEnd(); ++it)
+   {
+      settings_[it.key().toStdString()] = it.value().toString().toStdString();
+   }
+}
+
+void ImGuiQtSettingsStore::Write()
+{
+   QJsonObject root;
+   for (auto& settings : settings_)
+   {
+      root.insert(QString::fromStdString(settings.first),
+                  QString::fromStdString(settings.second));
+   }
+
+   // Serialize on the GUI thread, and write the snapshot off-thread
+   QByteArray data     = QJsonDocument(root).toJson();
+   QString    filename = filename_;
+
+   writePool_.start(
+      [data, filename]()
+      {
+         // Replace the file atomically
+         QSaveFile file(filename);
+         if (!file.open(QIODevice::OpenModeFlag::WriteOnly) ||
+             file.write(data) != data.size() || !file.commit())
+         {
+            qWarning("imgui_impl_qt: Could not write settings to %s: %s",
+                     qUtf8Printable(filename),
+                     qUtf8Printable(file.errorString()));
+         }
+      });
+}
+
+void ImGui_ImplQt_SetSettingsFile(const char* filename)
+{
+   ImGuiQtSettingsStore::SetFilename(
+      filename != nullptr ? QString::fromUtf8(filename) : QString());
+}
+
+//--------------------------------------------------------------------------------------------------------
+// MULTI-VIEWPORT / PLATFORM INTERFACE SUPPORT
+// This is an _advanced_ and _optional_ feature, allowing the backend to create
+// and handle multiple viewports simultaneously. If you are new to dear imgui or
+// creating a new binding for dear imgui, it is recommended that you completely
+// ignore this section first..
+//--------------------------------------------------------------------------------------------------------
+
+#ifdef IMGUI_HAS_DOCK
+
+// Hidden windows kept beyond this count are destroyed
+static constexpr std::size_t kMaxPooledWindows_ = 8u;
+
+static ImGui_ImplQt_Data* ImGui_ImplQt_GetViewportBackendData()
+{
+   ImGui_ImplQt_Data* bd = ImGui_ImplQt_GetBackendData();
+   IM_ASSERT(bd != nullptr);
+   return bd;
+}
+
+static ImGui_ImplQt_ViewportData*
+ImGui_ImplQt_GetViewportData(ImGuiViewport* viewport)
+{
+   return static_cast<ImGui_ImplQt_ViewportData*>(viewport->PlatformUserData);
+}
+
+static QWindow* ImGui_ImplQt_GetTopLevelWindow(QObject* object)
+{
+   if (object == nullptr)
+   {
+      return nullptr;
+   }
+   else if (object->isWidgetType())
+   {
+      return reinterpret_cast<QWidget*>(object)->window()->windowHandle();
+   }
+   else if (object->isWindowType())
+   {
+      return reinterpret_cast<QWindow*>(object);
+   }
+
+   return nullptr;
+}
+
+static void ImGui_ImplQt_CreateWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_GetViewportBackendData()->backend_->CreateViewportWindow(
+      viewport);
+}
+
+static void ImGui_ImplQt_DestroyWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_GetViewportBackendData()->backend_->DestroyViewportWindow(
+      viewport);
+}
+
+static void ImGui_ImplQt_ShowWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   vd->window_->show();
+}
+
+static ImVec2 ImGui_ImplQt_GetWindowPos(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   QPoint                     position;
+
+   if (vd->object_ == nullptr)
+   {
+      // Main object is assigned in the first call to ImGui_ImplQt_NewFrame()
+   }
+   else if (vd->object_->isWidgetType())
+   {
+      position = reinterpret_cast<QWidget*>(vd->object_)->mapToGlobal(QPoint());
+   }
+   else if (vd->object_->isWindowType())
+   {
+      position = reinterpret_cast<QWindow*>(vd->object_)->mapToGlobal(QPoint());
+   }
+
+   return ImVec2(static_cast<float>(position.x()),
+                 static_cast<float>(position.y()));
+}
+
+static void ImGui_ImplQt_SetWindowPos(ImGuiViewport* viewport, ImVec2 pos)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   ImGui_ImplQt_GetViewportBackendData()->backend_->IgnoreViewportMoveEvent(
+      viewport);
+   vd->window_->setPosition(static_cast<int>(pos.x), static_cast<int>(pos.y));
+}
+
+static ImVec2 ImGui_ImplQt_GetWindowSize(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   QSize                      size;
+
+   if (vd->object_ == nullptr)
+   {
+      // Main object is assigned in the first call to ImGui_ImplQt_NewFrame()
+   }
+   else if (vd->object_->isWidgetType())
+   {
+      size = reinterpret_cast<QWidget*>(vd->object_)->size();
+   }
+   else if (vd->object_->isWindowType())
+   {
+      size = reinterpret_cast<QWindow*>(vd->object_)->size();
+   }
+
+   return ImVec2(static_cast<float>(size.width()),
+                 static_cast<float>(size.height()));
+}
+
+static void ImGui_ImplQt_SetWindowSize(ImGuiViewport* viewport, ImVec2 size)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   ImGui_ImplQt_GetViewportBackendData()->backend_->IgnoreViewportResizeEvent(
+      viewport);
+   vd->window_->resize(static_cast<int>(size.x), static_cast<int>(size.y));
+}
+
+static void ImGui_ImplQt_SetWindowFocus(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   QWindow* window = ImGui_ImplQt_GetTopLevelWindow(vd->object_);
+   if (window != nullptr)
+   {
+      window->requestActivate();
+   }
+}
+
+static bool ImGui_ImplQt_GetWindowFocus(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   QWindow* window = ImGui_ImplQt_GetTopLevelWindow(vd->object_);
+   return window != nullptr && window->isActive();
+}
+
+static bool ImGui_ImplQt_GetWindowMinimized(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   QWindow* window = ImGui_ImplQt_GetTopLevelWindow(vd->object_);
+   return window != nullptr &&
+          window->windowStates().testFlag(Qt::WindowState::WindowMinimized);
+}
+
+static void ImGui_ImplQt_SetWindowTitle(ImGuiViewport* viewport,
+                                        const char*    title)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   vd->window_->setTitle(QString::fromUtf8(title));
+}
+
+static void ImGui_ImplQt_SetWindowAlpha(ImGuiViewport* viewport, float alpha)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   vd->window_->setOpacity(static_cast<qreal>(alpha));
+}
+
+static void ImGui_ImplQt_UpdateWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_GetViewportBackendData()->backend_->UpdateViewportWindow(
+      viewport);
+}
+
+#   if QT_CONFIG(opengl)
+static void ImGui_ImplQt_RenderWindow(ImGuiViewport* viewport, void*)
+{
+   ImGui_ImplQt_GetViewportBackendData()->backend_->RenderViewportWindow(
+      viewport);
+}
+
+static void ImGui_ImplQt_SwapBuffers(ImGuiViewport* viewport, void*)
+{
+   ImGui_ImplQt_GetViewportBackendData()->backend_->SwapViewportBuffers(
+      viewport);
+}
+#   endif
+
+Qt::WindowFlags
+ImGuiQtBackend::ViewportFlagsToWindowFlags(ImGuiViewportFlags viewportFlags)
+{
+   Qt::WindowFlags flags = Qt::WindowType::Window;
+
+   if (viewportFlags & ImGuiViewportFlags_NoDecoration)
+   {
+      flags |= Qt::WindowType::FramelessWindowHint;
+   }
+   if (viewportFlags & ImGuiViewportFlags_NoTaskBarIcon)
+   {
+      flags |= Qt::WindowType::Tool;
+   }
+   if (viewportFlags & ImGuiViewportFlags_TopMost)
+   {
+      flags |= Qt::WindowType::WindowStaysOnTopHint;
+   }
+
+   return flags;
+}
+
+QWindow* ImGuiQtBackend::AcquireViewportWindow(Qt::WindowFlags flags)
+{
+   QWindow* window = nullptr;
+
+   // Prefer a pooled window with matching flags, since changing the flags of a
+   // window may recreate its native window
+   auto it = std::find_if(windowPool_.begin(),
+                          windowPool_.end(),
+                          [=](QWindow* pooledWindow)
+                          { return pooledWindow->flags() == flags; });
+   if (it == windowPool_.end() && !windowPool_.empty())
+   {
+      it = std::prev(windowPool_.end());
+   }
+
+   if (it != windowPool_.end())
+   {
+      window = *it;
+      windowPool_.erase(it);
+   }
+   else
+   {
+      window = new QWindow();
+#   if QT_CONFIG(opengl)
+      QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+      format.setSwapInterval(0);
+      window->setSurfaceType(QSurface::SurfaceType::OpenGLSurface);
+      window->setFormat(format);
+#   endif
+      window->installEventFilter(this);
+   }
+
+   if (window->flags() != flags)
+   {
+      window->setFlags(flags);
+   }
+
+   return window;
+}
+
+void ImGuiQtBackend::ReleaseViewportWindow(QWindow* window)
+{
+   // Keep the native window and its surface, only hide it
+   window->hide();
+   window->setTransientParent(nullptr);
+   window->setOpacity(1.0);
+
+   if (windowPool_.size() < kMaxPooledWindows_)
+   {
+      windowPool_.push_back(window);
+   }
+   else
+   {
+      window->removeEventFilter(this);
+      window->deleteLater();
+   }
+}
+
+void ImGuiQtBackend::CreateViewportWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = IM_NEW(ImGui_ImplQt_ViewportData)();
+   viewport->PlatformUserData    = vd;
+
+   vd->flags_       = ViewportFlagsToWindowFlags(viewport->Flags);
+   vd->window_      = AcquireViewportWindow(vd->flags_);
+   vd->object_      = vd->window_;
+   vd->windowOwned_ = true;
+
+   // Keep viewport windows above the window of the main object
+   vd->window_->setTransientParent(ImGui_ImplQt_GetTopLevelWindow(mainObject_));
+
+   IgnoreViewportMoveEvent(viewport);
+   IgnoreViewportResizeEvent(viewport);
+   vd->window_->setGeometry(static_cast<int>(viewport->Pos.x),
+                            static_cast<int>(viewport->Pos.y),
+                            static_cast<int>(viewport->Size.x),
+                            static_cast<int>(viewport->Size.y));
+
+   viewportWindows_.emplace(vd->window_, viewport);
+   viewport->PlatformHandle = static_cast<void*>(vd->window_);
+}
+
+void ImGuiQtBackend::DestroyViewportWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   if (vd != nullptr)
+   {
+      if (vd->windowOwned_)
+      {
+         if (keyboardObject_ == vd->window_)
+         {
+            keyboardObject_ = nullptr;
+         }
+
+         viewportWindows_.erase(vd->window_);
+         ReleaseViewportWindow(vd->window_);
+      }
+
+      IM_DELETE(vd);
+   }
+
+   viewport->PlatformUserData = viewport->PlatformHandle = nullptr;
+}
+
+void ImGuiQtBackend::UpdateViewportWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+   if (!vd->windowOwned_)
+   {
+      return;
+   }
+
+   // Decoration and z-order flags can change during the lifetime of a viewport
+   Qt::WindowFlags flags = ViewportFlagsToWindowFlags(viewport->Flags);
+   if (flags != vd->flags_)
+   {
+      bool visible = vd->window_->isVisible();
+
+      vd->flags_ = flags;
+      vd->window_->setFlags(flags);
+
+      if (visible)
+      {
+         vd->window_->show();
+      }
+
+      viewport->PlatformRequestMove = viewport->PlatformRequestResize = true;
+   }
+}
+
+#   if QT_CONFIG(opengl)
+void ImGuiQtBackend::RenderViewportWindow(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+
+   previousContext_ = QOpenGLContext::currentContext();
+   previousSurface_ =
+      previousContext_ != nullptr ? previousContext_->surface() : nullptr;
+
+   if (viewportContext_ == nullptr)
+   {
+      // A single context, sharing resources with the renderer, is used for all
+      // viewport windows
+      viewportContext_ = std::make_unique<QOpenGLContext>();
+      viewportContext_->setFormat(vd->window_->requestedFormat());
+      viewportContext_->setShareContext(
+         previousContext_ != nullptr ? previousContext_ :
+                                       QOpenGLContext::globalShareContext());
+      viewportContext_->create();
+   }
+
+   viewportContext_->makeCurrent(vd->window_);
+}
+
+void ImGuiQtBackend::SwapViewportBuffers(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+
+   viewportContext_->swapBuffers(vd->window_);
+
+   // Restore the context of the main object
+   if (previousContext_ != nullptr)
+   {
+      previousContext_->makeCurrent(previousSurface_);
+   }
+   else
+   {
+      viewportContext_->doneCurrent();
+   }
+}
+#   endif
+
+void ImGuiQtBackend::IgnoreViewportMoveEvent(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_GetViewportData(viewport)->ignoreWindowPosEventFrame_ =
+      frameCount_;
+}
+
+void ImGuiQtBackend::IgnoreViewportResizeEvent(ImGuiViewport* viewport)
+{
+   ImGui_ImplQt_GetViewportData(viewport)->ignoreWindowSizeEventFrame_ =
+      frameCount_;
+}
+
+bool ImGuiQtBackend::HandleViewportEvent(ImGuiViewport* viewport,
+                                         QEvent*        event)
+{
+   ImGui_ImplQt_ViewportData* vd = ImGui_ImplQt_GetViewportData(viewport);
+
+   switch (event->type())
+   {
+   case QEvent::Close:
+      // Closing is requested from ImGui, the window is only hidden once the
+      // viewport is destroyed
+      viewport->PlatformRequestClose = true;
+      event->ignore();
+      return true;
+
+   case QEvent::Move:
+      // Ignore move events caused by ImGui_ImplQt_SetWindowPos()
+      if (frameCount_ > vd->ignoreWindowPosEventFrame_ + 1)
+      {
+         viewport->PlatformRequestMove = true;
+      }
+      break;
+
+   case QEvent::Resize:
+      // Ignore resize events caused by ImGui_ImplQt_SetWindowSize()
+      if (frameCount_ > vd->ignoreWindowSizeEventFrame_ + 1)
+      {
+         viewport->PlatformRequestResize = true;
+      }
+      break;
+
+   case QEvent::Expose:
+      // Viewport windows are rendered in the frame of the main object
+      if (mainObject_ != nullptr)
+      {
+         RequestUpdate(mainObject_);
+      }
+      break;
+
+   default:
+      break;
+   }
+
+   return false;
+}
+
+#endif // IMGUI_HAS_DOCK
+
+void ImGuiQtBackend::InitPlatformInterface()
+{
+#ifdef IMGUI_HAS_DOCK
+   // Register platform interface (will be coupled with a renderer interface)
+   ImGuiPlatformIO& platformIo            = ImGui::GetPlatformIO();
+   platformIo.Platform_CreateWindow       = ImGui_ImplQt_CreateWindow;
+   platformIo.Platform_DestroyWindow      = ImGui_ImplQt_DestroyWindow;
+   platformIo.Platform_ShowWindow         = ImGui_ImplQt_ShowWindow;
+   platformIo.Platform_SetWindowPos       = ImGui_ImplQt_SetWindowPos;
+   platformIo.Platform_GetWindowPos       = ImGui_ImplQt_GetWindowPos;
+   platformIo.Platform_SetWindowSize      = ImGui_ImplQt_SetWindowSize;
+   platformIo.Platform_GetWindowSize      = ImGui_ImplQt_GetWindowSize;
+   platformIo.Platform_SetWindowFocus     = ImGui_ImplQt_SetWindowFocus;
+   platformIo.Platform_GetWindowFocus     = ImGui_ImplQt_GetWindowFocus;
+   platformIo.Platform_GetWindowMinimized = ImGui_ImplQt_GetWindowMinimized;
+   platformIo.Platform_SetWindowTitle     = ImGui_ImplQt_SetWindowTitle;
+   platformIo.Platform_SetWindowAlpha     = ImGui_ImplQt_SetWindowAlpha;
+   platformIo.Platform_UpdateWindow       = ImGui_ImplQt_UpdateWindow;
+#   if QT_CONFIG(opengl)
+   platformIo.Platform_RenderWindow = ImGui_ImplQt_RenderWindow;
+   platformIo.Platform_SwapBuffers  = ImGui_ImplQt_SwapBuffers;
+#   endif
+
+   // Register main window handle (which is owned by the application, not by
+   // us). The object is assigned on each call to ImGui_ImplQt_NewFrame().
+   ImGuiViewport*             mainViewport = ImGui::GetMainViewport();
+   ImGui_ImplQt_ViewportData* vd = IM_NEW(ImGui_ImplQt_ViewportData)();
+   vd->windowOwned_              = false;
+   mainViewport->PlatformUserData = vd;
+
+   io_.BackendFlags |= ImGuiBackendFlags_PlatformHasViewports;
+#endif
+}
+
+void ImGuiQtBackend::ShutdownPlatformInterface()
+{
+#ifdef IMGUI_HAS_DOCK
+   ImGui::DestroyPlatformWindows();
+
+   for (QWindow* window : windowPool_)
+   {
+      delete window;
+   }
+   windowPool_.clear();
+
+#   if QT_CONFIG(opengl)
+   viewportContext_.reset();
+#   endif
+#endif
 }
@@ -9,6 +9,17 @@
 //  ImGui::IsKeyPressed(ImGuiKey_Space).
 //  [X] Platform: Mouse cursor shape and visibility. Disable with
 //  'io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange'.
+//  [X] Platform: Tablet and touch support, with per-frame pressure samples. See
+//  ImGui_ImplQt_GetPointerSamples().
+//  [X] Platform: Opt-in pointer motion prediction. See
+//  ImGui_ImplQt_SetPointerPrediction().
+//  [X] Platform: Multi-viewport support (multiple windows). Enable with
+//  'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'. Native windows are
+//  pooled and reused.
+//  [X] Platform: Settings of all registered objects persisted in a single file,
+//  written asynchronously. See ImGui_ImplQt_SetSettingsFile().
+//  [X] Renderer: QImage/QPixmap texture registry with LRU eviction and partial
+//  uploads. Requires texture callbacks, see ImGui_ImplQt_TextureCallbacks.
 
 // You can use unmodified imgui_impl_* files in your project. See examples/
 // folder for examples of using this. Prefer including the entire imgui/
@@ -19,17 +30,167 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include <imgui.h> // IMGUI_IMPL_API
 
+class QCursor;
+class QImage;
+class QObject;
+class QPixmap;
+class QRegion;
 class QWidget;
 class QWindow;
 
+struct ImGui_ImplQt_EventChannel;
+
+// Thread-safe handle to the event channel of a registered object
+typedef std::shared_ptr<ImGui_ImplQt_EventChannel> ImGui_ImplQt_EventHandle;
+
+// Texture callbacks, implemented by the application on top of its renderer.
+// Pixels are always RGBA32 (QImage::Format_RGBA8888), with rows separated by
+// 'stride' bytes. The callbacks are invoked from ImGui_ImplQt_GetTexture() and
+// ImGui_ImplQt_Shutdown(), with the rendering context current.
+struct ImGui_ImplQt_TextureCallbacks
+{
+   ImTextureID (*CreateTexture)(int         width,
+                                int         height,
+                                const void* pixels,
+                                int         stride,
+                                void*       userData);
+   void (*UpdateTexture)(ImTextureID texture,
+                         int         x,
+                         int         y,
+                         int         width,
+                         int         height,
+                         const void* pixels,
+                         int         stride,
+                         void*       userData);
+   void (*DestroyTexture)(ImTextureID texture, void* userData);
+   void* UserData;
+};
+
+// Tablet or touch sample, received since the previous frame
+struct ImGui_ImplQt_PointerSample
+{
+   ImVec2           Position;  // Same coordinate space as io.MousePos
+   float            Pressure;  // Normalized pressure [0..1]
+   float            TiltX;     // Pen tilt in degrees [-60..60], 0 for touch
+   float            TiltY;     // Pen tilt in degrees [-60..60], 0 for touch
+   double           Timestamp; // Event timestamp in seconds
+   int              PointId;   // Touch point ID, 0 for pen
+   ImGuiMouseSource Source;    // ImGuiMouseSource_Pen or _TouchScreen
+};
+
+// Backend state of the current context, to monitor long-running applications
+struct ImGui_ImplQt_BackendStats
+{
+   int    RegisteredObjects;     // Objects registered with the backend
+   size_t QueuedEvents;          // Input events waiting for a frame
+   size_t MaxQueuedEvents;       // Input events waiting for a frame, per object
+   size_t QueueCapacity;         // Input events kept per object at most
+   ImU64  DroppedEvents;         // Input events dropped from full queues
+   size_t PendingPointerSamples; // Tablet and touch samples waiting for a frame
+   size_t PendingPostedEvents;   // Events posted from other threads, waiting
+   float  NewFrameTime;          // Duration of the last ImGui_ImplQt_NewFrame()
+   float  PredictionError;       // Recent pointer prediction error, in pixels
+};
+
+struct ImGui_ImplQt_TextureStats
+{
+   ImU64  Hits;             // Lookups served without any upload
+   ImU64  Misses;           // Lookups requiring a texture to be created
+   ImU64  Updates;          // Lookups requiring a (partial) re-upload
+   ImU64  Evictions;        // Textures destroyed to stay within the budget
+   ImU64  UploadedBytes;    // Total bytes passed to Create/UpdateTexture
+   size_t ResidentBytes;    // Bytes currently held by registry textures
+   int    ResidentTextures; // Number of textures currently in the registry
+};
+
 IMGUI_IMPL_API bool ImGui_ImplQt_Init();
 IMGUI_IMPL_API void ImGui_ImplQt_Shutdown();
 IMGUI_IMPL_API void ImGui_ImplQt_NewFrame(QWidget* widget);
 IMGUI_IMPL_API void ImGui_ImplQt_NewFrame(QWindow* window);
 
+// Tablet and touch events of registered widgets and windows are consumed by the
+// backend, so Qt does not synthesize mouse events from them. These events no
+// longer reach tabletEvent() or touchEvent() of the object.
 IMGUI_IMPL_API void ImGui_ImplQt_RegisterWidget(QWidget* widget);
 IMGUI_IMPL_API void ImGui_ImplQt_RegisterWindow(QWindow* window);
 IMGUI_IMPL_API void ImGui_ImplQt_UnregisterWidget(QWidget* widget);
 IMGUI_IMPL_API void ImGui_ImplQt_UnregisterWindow(QWindow* window);
+
+// Custom hosts (e.g. ImGuiQuickItem) provide their own display size, a
+// callback to request a new frame when input is received, and optionally a
+// callback to set the mouse cursor of each frame.
+IMGUI_IMPL_API void ImGui_ImplQt_RegisterCustomObject(
+   QObject*                            object,
+   std::function<void()>               requestUpdate,
+   std::function<void(const QCursor&)> setCursor = {});
+IMGUI_IMPL_API void ImGui_ImplQt_UnregisterCustomObject(QObject* object);
+IMGUI_IMPL_API void ImGui_ImplQt_NewFrame(QObject* object,
+                                          ImVec2   displaySize,
+                                          float    framebufferScale);
+
+// Persists the settings of all registered objects in a single file, instead of
+// one imgui.ini per context. The file is read once, and written off the GUI
+// thread once changes settle for a second, or at most 5 s after a change.
+// Objects are keyed by objectName(), or by class name and registration order
+// if unnamed. Call before registering objects.
+IMGUI_IMPL_API void ImGui_ImplQt_SetSettingsFile(const char* filename);
+
+// Returns a handle which can be used from any thread to post events to the
+// object. Must be called from the GUI thread, with the context of the object
+// current. Posting to the handle after the object is unregistered is ignored.
+// Frames of custom objects are requested with their update callback.
+IMGUI_IMPL_API ImGui_ImplQt_EventHandle
+ImGui_ImplQt_GetEventHandle(QWidget* widget);
+IMGUI_IMPL_API ImGui_ImplQt_EventHandle
+ImGui_ImplQt_GetEventHandle(QWindow* window);
+IMGUI_IMPL_API ImGui_ImplQt_EventHandle
+ImGui_ImplQt_GetEventHandle(QObject* object);
+
+// Thread-safe. The event is invoked in the next ImGui_ImplQt_NewFrame() of the
+// object, and a frame is requested. Events are queued without locks, only the
+// first frame request of each frame posts a Qt event, which takes the lock of
+// the GUI thread's event queue. Returns false if the event was dropped.
+IMGUI_IMPL_API bool
+ImGui_ImplQt_PostEvent(const ImGui_ImplQt_EventHandle& handle,
+                       std::function<void(ImGuiIO& io)> event);
+
+// Thread-safe. Requests a frame of the object, coalesced into at most one
+// update() per frame, and at most one locked QCoreApplication::postEvent().
+IMGUI_IMPL_API void
+ImGui_ImplQt_RequestFrame(const ImGui_ImplQt_EventHandle& handle);
+
+IMGUI_IMPL_API ImGui_ImplQt_BackendStats ImGui_ImplQt_GetBackendStats();
+
+// Returns all tablet and touch samples received by the object of the current
+// frame, since its previous frame. Valid until the next call to
+// ImGui_ImplQt_NewFrame().
+IMGUI_IMPL_API const ImGui_ImplQt_PointerSample*
+ImGui_ImplQt_GetPointerSamples(int* count);
+
+// Opt-in. Extrapolates the pointer position of each frame to its expected
+// presentation time, one refresh interval of the screen after
+// ImGui_ImplQt_NewFrame(), from the pointer positions of the last 50 ms. The
+// predicted position is clamped at the bounds of the object, and its error is
+// reported by ImGui_ImplQt_GetBackendStats().
+IMGUI_IMPL_API void ImGui_ImplQt_SetPointerPrediction(bool enabled);
+
+IMGUI_IMPL_API void ImGui_ImplQt_SetTextureCallbacks(
+   const ImGui_ImplQt_TextureCallbacks& callbacks);
+IMGUI_IMPL_API void ImGui_ImplQt_SetTextureMemoryBudget(size_t bytes);
+IMGUI_IMPL_API ImGui_ImplQt_TextureStats ImGui_ImplQt_GetTextureStats();
+
+// Returns a texture for the image, keyed by QImage::cacheKey(). The texture is
+// only re-uploaded when the image contents changed since the previous call. If
+// a dirty region is given, only that region is uploaded, and only that region
+// of a pixmap is read back.
+IMGUI_IMPL_API ImTextureID ImGui_ImplQt_GetTexture(const QImage& image);
+IMGUI_IMPL_API ImTextureID ImGui_ImplQt_GetTexture(const QImage&  image,
+                                                   const QRegion& dirtyRegion);
+IMGUI_IMPL_API ImTextureID ImGui_ImplQt_GetTexture(const QPixmap& pixmap);
+IMGUI_IMPL_API ImTextureID ImGui_ImplQt_GetTexture(const QPixmap& pixmap,
+                                                   const QRegion& dirtyRegion);
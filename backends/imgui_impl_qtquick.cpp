@@ -0,0 +1,662 @@
+// dear imgui: Qt Quick host for the Qt Platform Backend
+// This needs to be used along with imgui_impl_qt, and a Renderer usable on the
+// Qt Quick render thread (e.g. OpenGL3)
+// (Requires: Qt 6.0+)
+
+// Implemented features:
+//  [X] Host: QQuickItem, with input events processed by imgui_impl_qt.
+//  [X] Renderer: Draw data rendered in the scene graph with a QSGRenderNode,
+//  without an intermediate framebuffer. Rendering is delegated to renderer
+//  functions on the render thread, or rasterized with QPainter when using the
+//  software scene graph backend.
+
+#include "imgui_impl_qtquick.hpp"
+
+#include <cmath>
+#include <unordered_map>
+
+#include <QCursor>
+#include <QHoverEvent>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QThread>
+#include <QWheelEvent>
+
+// Texture ID of the font atlas, when rasterized by the software renderer
+static const ImTextureID kSoftwareFontTexture_ = (ImTextureID) (intptr_t) 1;
+
+// Tinted font atlas images kept by the software renderer
+static constexpr std::size_t kMaxTintedFontImages_ = 64u;
+
+class ImGuiQuickRenderNode : public QSGRenderNode
+{
+private:
+   Q_DISABLE_COPY(ImGuiQuickRenderNode)
+
+public:
+   explicit ImGuiQuickRenderNode(QQuickWindow*                 window,
+                                 std::shared_ptr<ImGuiContext> context);
+   ~ImGuiQuickRenderNode();
+
+   void SetDrawData(const ImDrawData* drawData, const QImage& fontImage);
+   void SetRenderer(ImGuiQuickItem::Renderer renderer);
+   bool InitRenderer();
+
+   void           render(const RenderState* state) override;
+   void           releaseResources() override;
+   StateFlags     changedStates() const override;
+   RenderingFlags flags() const override;
+   QRectF         rect() const override;
+
+private:
+   bool          SoftwareRenderer() const;
+   void          ShutdownRenderer();
+   void          ClearDrawData();
+   void          RenderSoftware(QPainter* painter);
+   const QImage& TintedFontImage(ImU32 color);
+
+   QQuickWindow*                 window_;
+   std::shared_ptr<ImGuiContext> context_;
+   ImGuiQuickItem::Renderer      renderer_ {};
+   bool                          rendererInitialized_ {};
+   ImDrawData                    drawData_ {};
+   QRectF                        rect_ {};
+
+   QImage                            fontImage_ {};
+   std::unordered_map<ImU32, QImage> tintedFontImages_ {};
+};
+
+// Makes an ImGui context current for the lifetime of the scope
+class ImGuiQuickContextScope
+{
+private:
+   Q_DISABLE_COPY(ImGuiQuickContextScope)
+
+public:
+   explicit ImGuiQuickContextScope(ImGuiContext* context) :
+       previousContext_ {ImGui::GetCurrentContext()}
+   {
+      ImGui::SetCurrentContext(context);
+   }
+   ~ImGuiQuickContextScope() { ImGui::SetCurrentContext(previousContext_); }
+
+private:
+   ImGuiContext* previousContext_;
+};
+
+static QColor ImGui_ImplQtQuick_ToColor(ImU32 color)
+{
+   return QColor((color >> IM_COL32_R_SHIFT) & 0xFF,
+                 (color >> IM_COL32_G_SHIFT) & 0xFF,
+                 (color >> IM_COL32_B_SHIFT) & 0xFF,
+                 (color >> IM_COL32_A_SHIFT) & 0xFF);
+}
+
+ImGuiQuickItem::ImGuiQuickItem(QQuickItem* parent) : QQuickItem(parent)
+{
+   setFlag(QQuickItem::Flag::ItemHasContents);
+   setAcceptedMouseButtons(Qt::MouseButton::AllButtons);
+   setAcceptHoverEvents(true);
+   setAcceptTouchEvents(true);
+   setActiveFocusOnTab(true);
+
+   // Each item uses its own context, in order for Qt events to properly reach
+   // the intended ImGui target
+   ImGuiContext* previousContext = ImGui::GetCurrentContext();
+
+   context_ = std::shared_ptr<ImGuiContext>(
+      ImGui::CreateContext(),
+      [](ImGuiContext* context) { ImGui::DestroyContext(context); });
+   ImGui::SetCurrentContext(context_.get());
+
+   ImGui_ImplQt_Init();
+   ImGui_ImplQt_RegisterCustomObject(
+      this,
+      [this]() { RequestFrame(); },
+      [this](const QCursor& cursor) { setCursor(cursor); });
+
+   ImGui::SetCurrentContext(previousContext);
+}
+
+ImGuiQuickItem::~ImGuiQuickItem()
+{
+   ImGuiContext* previousContext = ImGui::GetCurrentContext();
+   ImGui::SetCurrentContext(context_.get());
+
+   ImGui_ImplQt_UnregisterCustomObject(this);
+   ImGui_ImplQt_Shutdown();
+
+   ImGui::SetCurrentContext(previousContext != context_.get() ?
+                               previousContext :
+                               nullptr);
+
+   // The context is destroyed once the render node shut the renderer down
+   context_.reset();
+}
+
+ImGuiContext* ImGuiQuickItem::Context() const
+{
+   return context_.get();
+}
+
+void ImGuiQuickItem::SetRenderer(Renderer renderer)
+{
+   renderer_        = std::move(renderer);
+   rendererChanged_ = true;
+   RequestFrame();
+}
+
+void ImGuiQuickItem::Frame()
+{
+   // Override to build the ImGui frame
+}
+
+void ImGuiQuickItem::RequestFrame()
+{
+   // The frame is built in updatePolish(), before synchronizing with the
+   // render thread
+   polish();
+   update();
+}
+
+void ImGuiQuickItem::geometryChange(const QRectF& newGeometry,
+                                    const QRectF& oldGeometry)
+{
+   QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+   if (newGeometry.size() != oldGeometry.size())
+   {
+      RequestFrame();
+   }
+}
+
+void ImGuiQuickItem::itemChange(ItemChange change, const ItemChangeData& value)
+{
+   QQuickItem::itemChange(change, value);
+
+   if (change == ItemChange::ItemSceneChange && value.window != nullptr)
+   {
+      RequestFrame();
+   }
+}
+
+void ImGuiQuickItem::updatePolish()
+{
+   ImGuiQuickContextScope scope(context_.get());
+
+   ImGuiIO&      io               = ImGui::GetIO();
+   QQuickWindow* quickWindow      = window();
+   float         pixelRatio       = 1.0f;
+   bool          softwareRenderer = false;
+
+   if (quickWindow != nullptr)
+   {
+      pixelRatio =
+         static_cast<float>(quickWindow->effectiveDevicePixelRatio());
+      softwareRenderer = quickWindow->rendererInterface()->graphicsApi() ==
+                         QSGRendererInterface::GraphicsApi::Software;
+   }
+
+   if (!io.Fonts->IsBuilt() ||
+       (softwareRenderer && softwareFontImage_.isNull()))
+   {
+      unsigned char* pixels;
+      int            width;
+      int            height;
+      io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+      if (softwareRenderer)
+      {
+         // The font atlas is rasterized with QPainter, keep a copy for the
+         // render thread
+         softwareFontImage_ =
+            QImage(pixels, width, height, QImage::Format::Format_RGBA8888)
+               .convertToFormat(QImage::Format::Format_ARGB32_Premultiplied);
+         io.Fonts->SetTexID(kSoftwareFontTexture_);
+      }
+   }
+
+   ImGui_ImplQt_NewFrame(this,
+                         ImVec2(static_cast<float>(width()),
+                                static_cast<float>(height())),
+                         pixelRatio);
+   ImGui::NewFrame();
+
+   Frame();
+
+   ImGui::Render();
+
+   // Draw data remains valid until the next frame, and is copied to the render
+   // node while the GUI thread is blocked
+   drawData_   = ImGui::GetDrawData();
+   frameReady_ = true;
+}
+
+QSGNode* ImGuiQuickItem::updatePaintNode(QSGNode* node,
+                                         UpdatePaintNodeData* /* data */)
+{
+   ImGuiQuickRenderNode* renderNode = static_cast<ImGuiQuickRenderNode*>(node);
+
+   if (renderNode == nullptr)
+   {
+#ifndef GImGui
+      // The threaded render loop renders concurrently with the GUI thread, and
+      // both set the current context
+      if (QThread::currentThread() != thread())
+      {
+         qWarning("ImGuiQuickItem: The threaded render loop requires a "
+                  "thread-local GImGui (see imconfig.h), or "
+                  "QSG_RENDER_LOOP=basic");
+         IM_ASSERT(false && "Threaded render loop without thread-local GImGui");
+      }
+#endif
+
+      renderNode       = new ImGuiQuickRenderNode(window(), context_);
+      rendererChanged_ = true;
+   }
+
+   if (rendererChanged_)
+   {
+      renderNode->SetRenderer(renderer_);
+      rendererChanged_ = false;
+   }
+
+   if (renderNode->InitRenderer())
+   {
+      // Frames built before the renderer created its font texture reference
+      // another texture, build a new one
+      frameReady_ = false;
+      QMetaObject::invokeMethod(
+         this,
+         [this]() { RequestFrame(); },
+         Qt::ConnectionType::QueuedConnection);
+   }
+
+   if (frameReady_)
+   {
+      renderNode->SetDrawData(drawData_, softwareFontImage_);
+      frameReady_ = false;
+   }
+
+   renderNode->markDirty(QSGNode::DirtyStateBit::DirtyMaterial);
+
+   return renderNode;
+}
+
+void ImGuiQuickItem::hoverEnterEvent(QHoverEvent* event)
+{
+   // Input is queued by the event filter of the Qt backend
+   event->accept();
+}
+
+void ImGuiQuickItem::hoverMoveEvent(QHoverEvent* event)
+{
+   event->accept();
+}
+
+void ImGuiQuickItem::hoverLeaveEvent(QHoverEvent* event)
+{
+   event->accept();
+}
+
+void ImGuiQuickItem::keyPressEvent(QKeyEvent* event)
+{
+   event->accept();
+}
+
+void ImGuiQuickItem::keyReleaseEvent(QKeyEvent* event)
+{
+   event->accept();
+}
+
+void ImGuiQuickItem::mouseMoveEvent(QMouseEvent* event)
+{
+   event->accept();
+}
+
+void ImGuiQuickItem::mousePressEvent(QMouseEvent* event)
+{
+   // Accepting the press grabs the mouse, and receive keyboard input
+   forceActiveFocus(Qt::FocusReason::MouseFocusReason);
+   event->accept();
+}
+
+void ImGuiQuickItem::mouseReleaseEvent(QMouseEvent* event)
+{
+   event->accept();
+}
+
+void ImGuiQuickItem::wheelEvent(QWheelEvent* event)
+{
+   event->accept();
+}
+
+ImGuiQuickRenderNode::ImGuiQuickRenderNode(
+   QQuickWindow* window, std::shared_ptr<ImGuiContext> context) :
+    window_ {window}, context_ {std::move(context)}
+{
+}
+
+ImGuiQuickRenderNode::~ImGuiQuickRenderNode()
+{
+   ShutdownRenderer();
+   ClearDrawData();
+
+   // The list storage is also allocated by the context of the item
+   ImGuiQuickContextScope scope(context_.get());
+   drawData_.CmdLists.clear();
+}
+
+bool ImGuiQuickRenderNode::SoftwareRenderer() const
+{
+   return window_ == nullptr ||
+          window_->rendererInterface()->graphicsApi() ==
+             QSGRendererInterface::GraphicsApi::Software;
+}
+
+void ImGuiQuickRenderNode::SetRenderer(ImGuiQuickItem::Renderer renderer)
+{
+   // Resources of the previous renderer are released by that renderer
+   ShutdownRenderer();
+   ClearDrawData();
+
+   renderer_ = std::move(renderer);
+}
+
+bool ImGuiQuickRenderNode::InitRenderer()
+{
+   if (rendererInitialized_ || !renderer_.Render || SoftwareRenderer())
+   {
+      return false;
+   }
+
+   ImGuiQuickContextScope scope(context_.get());
+
+   if (renderer_.Init)
+   {
+      renderer_.Init();
+   }
+
+   // Renderers typically create their font texture in their first NewFrame
+   if (renderer_.NewFrame)
+   {
+      renderer_.NewFrame();
+   }
+
+   rendererInitialized_ = true;
+   return true;
+}
+
+void ImGuiQuickRenderNode::releaseResources()
+{
+   ShutdownRenderer();
+}
+
+void ImGuiQuickRenderNode::ShutdownRenderer()
+{
+   if (!rendererInitialized_)
+   {
+      return;
+   }
+
+   ImGuiQuickContextScope scope(context_.get());
+
+   if (renderer_.Shutdown)
+   {
+      renderer_.Shutdown();
+   }
+
+   rendererInitialized_ = false;
+}
+
+void ImGuiQuickRenderNode::SetDrawData(const ImDrawData* drawData,
+                                       const QImage&     fontImage)
+{
+   ClearDrawData();
+
+   if (fontImage.cacheKey() != fontImage_.cacheKey())
+   {
+      fontImage_ = fontImage;
+      tintedFontImages_.clear();
+   }
+
+   if (drawData == nullptr || !drawData->Valid)
+   {
+      return;
+   }
+
+   // Copy the draw lists, since the GUI thread builds the next frame while the
+   // render thread renders this one
+   ImGuiQuickContextScope scope(context_.get());
+
+   drawData_.Valid            = true;
+   drawData_.DisplayPos       = drawData->DisplayPos;
+   drawData_.DisplaySize      = drawData->DisplaySize;
+   drawData_.FramebufferScale = drawData->FramebufferScale;
+
+   for (ImDrawList* drawList : drawData->CmdLists)
+   {
+      drawData_.CmdLists.push_back(drawList->CloneOutput());
+      drawData_.TotalVtxCount += drawList->VtxBuffer.Size;
+      drawData_.TotalIdxCount += drawList->IdxBuffer.Size;
+   }
+   drawData_.CmdListsCount = drawData_.CmdLists.Size;
+
+   rect_ = QRectF(0.0, 0.0, drawData_.DisplaySize.x, drawData_.DisplaySize.y);
+
+   if (rendererInitialized_ && renderer_.NewFrame)
+   {
+      renderer_.NewFrame();
+   }
+}
+
+void ImGuiQuickRenderNode::ClearDrawData()
+{
+   // Draw lists are freed by the context which allocated them, and the GUI
+   // thread is blocked whenever the node synchronizes or is destroyed, so the
+   // allocation counters of the GUI thread contexts are never modified
+   ImGuiQuickContextScope scope(context_.get());
+
+   for (ImDrawList* drawList : drawData_.CmdLists)
+   {
+      IM_DELETE(drawList);
+   }
+
+   drawData_.Clear();
+}
+
+void ImGuiQuickRenderNode::render(const RenderState* state)
+{
+   if (!drawData_.Valid || window_ == nullptr)
+   {
+      return;
+   }
+
+   if (SoftwareRenderer())
+   {
+      QPainter* painter =
+         static_cast<QPainter*>(window_->rendererInterface()->getResource(
+            window_, QSGRendererInterface::Resource::PainterResource));
+
+      if (painter != nullptr)
+      {
+         painter->save();
+         painter->setTransform(matrix()->toTransform());
+         painter->setOpacity(inheritedOpacity());
+
+         const QRegion* clipRegion = state->clipRegion();
+         if (clipRegion != nullptr && !clipRegion->isEmpty())
+         {
+            painter->setClipRegion(*clipRegion,
+                                   Qt::ClipOperation::ReplaceClip);
+         }
+
+         RenderSoftware(painter);
+         painter->restore();
+      }
+
+      return;
+   }
+
+   // Resources are recreated by the next synchronization, once released
+   if (!rendererInitialized_)
+   {
+      return;
+   }
+
+   // Renderers project the draw data onto the whole render target, so express
+   // the draw data in window coordinates using the translation of the node
+   QPointF origin      = matrix()->map(QPointF());
+   ImVec2  displayPos  = drawData_.DisplayPos;
+   ImVec2  displaySize = drawData_.DisplaySize;
+
+   drawData_.DisplayPos  = ImVec2(displayPos.x - static_cast<float>(origin.x()),
+                                 displayPos.y - static_cast<float>(origin.y()));
+   drawData_.DisplaySize = ImVec2(static_cast<float>(window_->width()),
+                                  static_cast<float>(window_->height()));
+
+   {
+      ImGuiQuickContextScope scope(context_.get());
+      renderer_.Render(&drawData_, state);
+   }
+
+   drawData_.DisplayPos  = displayPos;
+   drawData_.DisplaySize = displaySize;
+}
+
+void ImGuiQuickRenderNode::RenderSoftware(QPainter* painter)
+{
+   const ImVec2 displayPos = drawData_.DisplayPos;
+
+   painter->setRenderHint(QPainter::RenderHint::Antialiasing, false);
+   painter->setPen(Qt::PenStyle::NoPen);
+
+   for (const ImDrawList* drawList : drawData_.CmdLists)
+   {
+      const ImDrawVert* vtxBuffer = drawList->VtxBuffer.Data;
+      const ImDrawIdx*  idxBuffer = drawList->IdxBuffer.Data;
+
+      for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+      {
+         if (cmd.UserCallback != nullptr)
+         {
+            // User callbacks require a renderer
+            continue;
+         }
+
+         QRectF clipRect(QPointF(cmd.ClipRect.x - displayPos.x,
+                                 cmd.ClipRect.y - displayPos.y),
+                         QPointF(cmd.ClipRect.z - displayPos.x,
+                                 cmd.ClipRect.w - displayPos.y));
+         if (clipRect.isEmpty())
+         {
+            continue;
+         }
+
+         painter->save();
+         painter->setClipRect(clipRect, Qt::ClipOperation::IntersectClip);
+
+         const bool fontTexture = cmd.GetTexID() == kSoftwareFontTexture_ &&
+                                  !fontImage_.isNull();
+
+         for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+         {
+            const ImDrawVert* v[3];
+            QPointF           points[3];
+
+            for (int j = 0; j < 3; ++j)
+            {
+               v[j] = &vtxBuffer[cmd.VtxOffset +
+                                 idxBuffer[cmd.IdxOffset + i + j]];
+               points[j] = QPointF(v[j]->pos.x - displayPos.x,
+                                   v[j]->pos.y - displayPos.y);
+            }
+
+            // Map texture coordinates onto the triangle. Untextured geometry
+            // uses a single texel, and is filled with the vertex color.
+            const float u0  = v[0]->uv.x * fontImage_.width();
+            const float w0  = v[0]->uv.y * fontImage_.height();
+            const float du1 = v[1]->uv.x * fontImage_.width() - u0;
+            const float dv1 = v[1]->uv.y * fontImage_.height() - w0;
+            const float du2 = v[2]->uv.x * fontImage_.width() - u0;
+            const float dv2 = v[2]->uv.y * fontImage_.height() - w0;
+            const float det = du1 * dv2 - du2 * dv1;
+
+            if (fontTexture && std::abs(det) > 1e-3f)
+            {
+               const QPointF e1 = points[1] - points[0];
+               const QPointF e2 = points[2] - points[0];
+
+               const qreal m11 = (e1.x() * dv2 - e2.x() * dv1) / det;
+               const qreal m21 = (e2.x() * du1 - e1.x() * du2) / det;
+               const qreal m12 = (e1.y() * dv2 - e2.y() * dv1) / det;
+               const qreal m22 = (e2.y() * du1 - e1.y() * du2) / det;
+
+               QBrush brush(TintedFontImage(v[0]->col));
+               brush.setTransform(
+                  QTransform(m11,
+                             m12,
+                             m21,
+                             m22,
+                             points[0].x() - m11 * u0 - m21 * w0,
+                             points[0].y() - m12 * u0 - m22 * w0));
+               painter->setBrush(brush);
+            }
+            else
+            {
+               painter->setBrush(ImGui_ImplQtQuick_ToColor(v[0]->col));
+            }
+
+            painter->drawConvexPolygon(points, 3);
+         }
+
+         painter->restore();
+      }
+   }
+}
+
+const QImage& ImGuiQuickRenderNode::TintedFontImage(ImU32 color)
+{
+   auto it = tintedFontImages_.find(color);
+   if (it != tintedFontImages_.cend())
+   {
+      return it->second;
+   }
+
+   if (tintedFontImages_.size() >= kMaxTintedFontImages_)
+   {
+      tintedFontImages_.clear();
+   }
+
+   // The font atlas is white, multiply it by the color
+   QImage   tintedImage = fontImage_.copy();
+   QPainter painter(&tintedImage);
+   painter.setCompositionMode(
+      QPainter::CompositionMode::CompositionMode_SourceIn);
+   painter.fillRect(tintedImage.rect(), ImGui_ImplQtQuick_ToColor(color));
+   painter.end();
+
+   auto result = tintedFontImages_.emplace(color, std::move(tintedImage));
+   return result.first->second;
+}
+
+QSGRenderNode::StateFlags ImGuiQuickRenderNode::changedStates() const
+{
+   return StateFlag::DepthState | StateFlag::StencilState |
+          StateFlag::ScissorState | StateFlag::ColorState |
+          StateFlag::BlendState | StateFlag::CullState |
+          StateFlag::ViewportState | StateFlag::RenderTargetState;
+}
+
+QSGRenderNode::RenderingFlags ImGuiQuickRenderNode::flags() const
+{
+   return RenderingFlag::BoundedRectRendering;
+}
+
+QRectF ImGuiQuickRenderNode::rect() const
+{
+   return rect_;
+}
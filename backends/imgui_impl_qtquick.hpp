@@ -0,0 +1,94 @@
+// dear imgui: Qt Quick host for the Qt Platform Backend
+// This needs to be used along with imgui_impl_qt, and a Renderer usable on the
+// Qt Quick render thread (e.g. OpenGL3)
+// (Requires: Qt 6.0+)
+
+// Implemented features:
+//  [X] Host: QQuickItem, with input events processed by imgui_impl_qt.
+//  [X] Renderer: Draw data rendered in the scene graph with a QSGRenderNode,
+//  without an intermediate framebuffer. Rendering is delegated to renderer
+//  functions on the render thread, or rasterized with QPainter when using the
+//  software scene graph backend.
+
+// QPainter fills each triangle with a single color, so anti-aliased fringes are
+// drawn opaque. With the software scene graph backend, applications may disable
+// AntiAliasedLines, AntiAliasedLinesUseTex and AntiAliasedFill in their style.
+
+// Each ImGuiQuickItem owns its own ImGui context. The ImGui frame is built on
+// the GUI thread in updatePolish(), and a copy of the draw data is rendered on
+// the render thread. Renderer functions are invoked on the render thread, with
+// the context of the item current. Init, NewFrame and Shutdown are invoked
+// while the GUI thread is blocked. Render runs concurrently with the GUI thread
+// when the threaded render loop is used, which requires GImGui to be
+// thread-local (see imconfig.h). Otherwise, the basic render loop must be used
+// (QSG_RENDER_LOOP=basic), which is asserted when the render node is created.
+
+#pragma once
+
+#include "imgui_impl_qt.hpp"
+
+#include <QImage>
+#include <QQuickItem>
+#include <QSGRenderNode>
+
+class ImGuiQuickItem : public QQuickItem
+{
+   Q_OBJECT
+   Q_DISABLE_COPY(ImGuiQuickItem)
+
+public:
+   // Invoked on the render thread with the graphics API of the scene graph.
+   // Positions in the draw data are in window coordinates.
+   typedef std::function<void(ImDrawData*                        drawData,
+                              const QSGRenderNode::RenderState* state)>
+      RenderFunction;
+
+   // Renderer backend functions (e.g. ImGui_ImplOpenGL3_Init()). Init and
+   // NewFrame are invoked before the first frame, NewFrame once per frame, and
+   // Shutdown when the graphics resources of the item are released.
+   struct Renderer
+   {
+      std::function<void()> Init;
+      std::function<void()> NewFrame;
+      RenderFunction        Render;
+      std::function<void()> Shutdown;
+   };
+
+   explicit ImGuiQuickItem(QQuickItem* parent = nullptr);
+   ~ImGuiQuickItem();
+
+   ImGuiContext* Context() const;
+   void          SetRenderer(Renderer renderer);
+
+protected:
+   // Invoked on the GUI thread, between ImGui::NewFrame() and ImGui::Render()
+   virtual void Frame();
+
+   void     geometryChange(const QRectF& newGeometry,
+                           const QRectF& oldGeometry) override;
+   void     itemChange(ItemChange change, const ItemChangeData& value) override;
+   void     updatePolish() override;
+   QSGNode* updatePaintNode(QSGNode* node, UpdatePaintNodeData* data) override;
+
+   void hoverEnterEvent(QHoverEvent* event) override;
+   void hoverMoveEvent(QHoverEvent* event) override;
+   void hoverLeaveEvent(QHoverEvent* event) override;
+   void keyPressEvent(QKeyEvent* event) override;
+   void keyReleaseEvent(QKeyEvent* event) override;
+   void mouseMoveEvent(QMouseEvent* event) override;
+   void mousePressEvent(QMouseEvent* event) override;
+   void mouseReleaseEvent(QMouseEvent* event) override;
+   void wheelEvent(QWheelEvent* event) override;
+
+private:
+   void RequestFrame();
+
+   // Shared with the render node, which shuts the renderer down
+   std::shared_ptr<ImGuiContext> context_ {};
+
+   ImDrawData* drawData_ {};
+   Renderer    renderer_ {};
+   bool        frameReady_ {};
+   bool        rendererChanged_ {};
+   QImage      softwareFontImage_ {};
+};
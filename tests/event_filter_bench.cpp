@@ -0,0 +1,96 @@
+// Benchmark of the event filter on events it does not process
+// Sends paint and update requests to an object registered with the backend,
+// and to an unregistered object as a baseline. Built twice, with and without
+// the event type fast path (IMGUI_IMPL_QT_DISABLE_EVENT_MASK), to compare the
+// filter before and after. Run with QT_QPA_PLATFORM=offscreen.
+
+#include "imgui_impl_qt.hpp"
+
+#include <memory>
+
+#include <QGuiApplication>
+#include <QPaintEvent>
+#include <QTest>
+
+class ImGuiQtEventFilterBench : public QObject
+{
+   Q_OBJECT
+
+private slots:
+   void initTestCase();
+   void cleanupTestCase();
+   void unprocessedEvent_data();
+   void unprocessedEvent();
+
+private:
+   ImGuiContext*            context_ {};
+   std::unique_ptr<QObject> registered_ {};
+   std::unique_ptr<QObject> unregistered_ {};
+};
+
+void ImGuiQtEventFilterBench::initTestCase()
+{
+   IMGUI_CHECKVERSION();
+   context_ = ImGui::CreateContext();
+
+   ImGui::GetIO().IniFilename = nullptr;
+
+   QVERIFY(ImGui_ImplQt_Init());
+
+   registered_   = std::make_unique<QObject>();
+   unregistered_ = std::make_unique<QObject>();
+   ImGui_ImplQt_RegisterCustomObject(registered_.get(), []() {});
+}
+
+void ImGuiQtEventFilterBench::cleanupTestCase()
+{
+   ImGui_ImplQt_UnregisterCustomObject(registered_.get());
+   registered_.reset();
+   unregistered_.reset();
+
+   ImGui_ImplQt_Shutdown();
+   ImGui::DestroyContext(context_);
+}
+
+void ImGuiQtEventFilterBench::unprocessedEvent_data()
+{
+   QTest::addColumn<bool>("paint");
+   QTest::addColumn<bool>("registered");
+
+   QTest::newRow("Paint/unregistered") << true << false;
+   QTest::newRow("Paint/registered") << true << true;
+   QTest::newRow("UpdateRequest/unregistered") << false << false;
+   QTest::newRow("UpdateRequest/registered") << false << true;
+}
+
+void ImGuiQtEventFilterBench::unprocessedEvent()
+{
+   QFETCH(bool, paint);
+   QFETCH(bool, registered);
+
+   QObject*    object = registered ? registered_.get() : unregistered_.get();
+   QPaintEvent paintEvent(QRect(0, 0, 640, 480));
+   QEvent      updateRequest(QEvent::Type::UpdateRequest);
+   QEvent*     event  = paint ? static_cast<QEvent*>(&paintEvent) :
+                                &updateRequest;
+
+   QBENCHMARK
+   {
+      QCoreApplication::sendEvent(object, event);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   // Headless, unless another platform is requested
+   if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+   {
+      qputenv("QT_QPA_PLATFORM", "offscreen");
+   }
+
+   QGuiApplication         app(argc, argv);
+   ImGuiQtEventFilterBench bench;
+   return QTest::qExec(&bench, argc, argv);
+}
+
+#include "event_filter_bench.moc"
@@ -0,0 +1,102 @@
+// Test of the Qt Quick host with the software scene graph backend
+// Renders an ImGuiQuickItem with the QPainter rasterizer, and checks untextured
+// geometry and text (tinted font atlas) reach the window. Run with
+// QT_QPA_PLATFORM=offscreen.
+
+#include "imgui_impl_qtquick.hpp"
+
+#include <QGuiApplication>
+#include <QQuickWindow>
+#include <QTest>
+
+class ImGuiQuickSoftwareItem : public ImGuiQuickItem
+{
+protected:
+   void Frame() override
+   {
+      // Anti-aliased fringes would be drawn opaque by QPainter
+      ImGuiStyle& style            = ImGui::GetStyle();
+      style.AntiAliasedLines       = false;
+      style.AntiAliasedLinesUseTex = false;
+      style.AntiAliasedFill        = false;
+
+      ImDrawList* drawList = ImGui::GetForegroundDrawList();
+      drawList->AddRectFilled(
+         ImVec2(10.0f, 10.0f), ImVec2(60.0f, 60.0f), IM_COL32(255, 0, 0, 255));
+      drawList->AddText(
+         ImVec2(10.0f, 80.0f), IM_COL32(255, 255, 255, 255), "ImGui ImGui");
+   }
+};
+
+class ImGuiQuickSoftwareTest : public QObject
+{
+   Q_OBJECT
+
+private slots:
+   void initTestCase();
+   void render();
+};
+
+void ImGuiQuickSoftwareTest::initTestCase()
+{
+   QQuickWindow::setGraphicsApi(QSGRendererInterface::GraphicsApi::Software);
+}
+
+void ImGuiQuickSoftwareTest::render()
+{
+   QQuickWindow window;
+   window.setColor(Qt::GlobalColor::black);
+   window.resize(200, 120);
+
+   ImGuiQuickSoftwareItem* item = new ImGuiQuickSoftwareItem();
+   item->setParentItem(window.contentItem());
+   item->setSize(QSizeF(200.0, 120.0));
+
+   window.show();
+   QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+   QCOMPARE(window.rendererInterface()->graphicsApi(),
+            QSGRendererInterface::GraphicsApi::Software);
+
+   const QImage image = window.grabWindow();
+   QVERIFY(!image.isNull());
+
+   // Untextured geometry is filled with the vertex color
+   const QColor fill = image.pixelColor(image.width() * 35 / 200,
+                                        image.height() * 35 / 120);
+   QVERIFY2(fill.red() > 200 && fill.green() < 50 && fill.blue() < 50,
+            qPrintable(fill.name()));
+
+   // Text is drawn from the tinted font atlas
+   const qreal scale = static_cast<qreal>(image.width()) / 200.0;
+   const QRect textRect(10, 80, 60, 14);
+   int         lit = 0;
+   for (int y = textRect.top(); y <= textRect.bottom(); ++y)
+   {
+      for (int x = textRect.left(); x <= textRect.right(); ++x)
+      {
+         const QColor color = image.pixelColor(static_cast<int>(x * scale),
+                                               static_cast<int>(y * scale));
+         if (color.lightness() > 128)
+         {
+            ++lit;
+         }
+      }
+   }
+   QVERIFY2(lit > 20, qPrintable(QString("%1 text pixels").arg(lit)));
+}
+
+int main(int argc, char* argv[])
+{
+   // Headless, unless another platform is requested
+   if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+   {
+      qputenv("QT_QPA_PLATFORM", "offscreen");
+   }
+
+   QGuiApplication        app(argc, argv);
+   ImGuiQuickSoftwareTest test;
+   return QTest::qExec(&test, argc, argv);
+}
+
+#include "quick_software_test.moc"
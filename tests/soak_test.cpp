@@ -0,0 +1,442 @@
+// Soak test for the Qt Platform Backend
+// Churns contexts, and registration, focus, clipboard, input and posted events
+// of widgets for a number of rounds, and fails on upward trends of resident
+// memory, event queues and p99 ImGui_ImplQt_NewFrame() times. Run with
+// QT_QPA_PLATFORM=offscreen. The number of rounds is read from
+// IMGUI_QT_SOAK_ROUNDS.
+
+#include "imgui_impl_qt.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QDir>
+#include <QEnterEvent>
+#include <QFile>
+#include <QFocusEvent>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QWheelEvent>
+#include <QWidget>
+
+#ifdef Q_OS_LINUX
+#   include <unistd.h>
+#endif
+
+// Rounds ignored by trend checks, while allocators and caches warm up
+static constexpr int kWarmupRounds_ = 2;
+
+// Contexts created and destroyed each round
+static constexpr int kContextsPerRound_ = 3;
+
+// Frames per round, of each context
+static constexpr int kFramesPerRound_ = 250;
+
+// Frames between replacing the rendered widget with a new one
+static constexpr int kFramesPerWidget_ = 50;
+
+struct ImGuiQtSoakContext
+{
+   ImGuiContext*            context_ {};
+   std::unique_ptr<QWidget> widget_ {};
+   std::unique_ptr<QWidget> idleWidget_ {};
+   ImGui_ImplQt_EventHandle widgetHandle_ {};
+   ImGui_ImplQt_EventHandle idleWidgetHandle_ {};
+};
+
+struct ImGuiQtSoakSample
+{
+   double residentBytes_ {};
+   size_t queuedEvents_ {};
+   ImU64  droppedEvents_ {};
+   double newFrameTime_ {};
+};
+
+class ImGuiQtSoakTest : public QObject
+{
+   Q_OBJECT
+
+private slots:
+   void initTestCase();
+   void soak();
+
+private:
+   void CreateContext(ImGuiQtSoakContext& context);
+   void DestroyContext(ImGuiQtSoakContext& context);
+   void ReplaceWidget(ImGuiQtSoakContext& context);
+   void Frame(QWidget* widget);
+   void SendInput(QWidget* widget, int frame);
+
+   static double ResidentBytes();
+   static double Slope(const std::vector<double>& samples);
+   static double Mean(const std::vector<double>& samples);
+   static double Percentile(std::vector<double> samples, double percentile);
+
+   QTemporaryDir settingsDir_ {};
+};
+
+void ImGuiQtSoakTest::initTestCase()
+{
+   IMGUI_CHECKVERSION();
+
+   // Settings keys are assigned and released with each context
+   QVERIFY(settingsDir_.isValid());
+   ImGui_ImplQt_SetSettingsFile(
+      QDir(settingsDir_.path()).filePath("imgui.json").toUtf8().constData());
+}
+
+void ImGuiQtSoakTest::soak()
+{
+   int rounds = qEnvironmentVariableIntValue("IMGUI_QT_SOAK_ROUNDS");
+   if (rounds <= 0)
+   {
+      rounds = 20;
+   }
+   QVERIFY2(rounds > kWarmupRounds_ + 3, "Not enough rounds to find trends");
+
+   std::vector<ImGuiQtSoakSample> samples;
+   std::size_t                    queueCapacity = 0u;
+
+   for (int round = 0; round < rounds; ++round)
+   {
+      std::vector<ImGuiQtSoakContext> contexts(kContextsPerRound_);
+      std::vector<double>             newFrameTimes;
+
+      for (ImGuiQtSoakContext& context : contexts)
+      {
+         CreateContext(context);
+      }
+
+      for (int i = 0; i < kFramesPerRound_; ++i)
+      {
+         const int frame = round * kFramesPerRound_ + i;
+
+         for (ImGuiQtSoakContext& context : contexts)
+         {
+            ImGui::SetCurrentContext(context.context_);
+
+            if (frame % kFramesPerWidget_ == kFramesPerWidget_ - 1)
+            {
+               ReplaceWidget(context);
+            }
+
+            if (frame % 10 == 0)
+            {
+               QGuiApplication::clipboard()->setText(QString::number(frame));
+               QCoreApplication::processEvents();
+               QCOMPARE(QString(ImGui::GetClipboardText()),
+                        QString::number(frame));
+               ImGui::SetClipboardText("imgui-backend-qt");
+            }
+
+            SendInput(context.widget_.get(), frame);
+            SendInput(context.idleWidget_.get(), frame);
+            ImGui_ImplQt_PostEvent(context.widgetHandle_,
+                                   [](ImGuiIO& io) { io.AddFocusEvent(true); });
+            ImGui_ImplQt_PostEvent(context.idleWidgetHandle_,
+                                   [](ImGuiIO& io) { io.AddFocusEvent(true); });
+            Frame(context.widget_.get());
+
+            newFrameTimes.push_back(
+               ImGui_ImplQt_GetBackendStats().NewFrameTime);
+         }
+      }
+
+      ImGuiQtSoakSample sample {};
+
+      for (ImGuiQtSoakContext& context : contexts)
+      {
+         ImGui::SetCurrentContext(context.context_);
+         const ImGui_ImplQt_BackendStats stats = ImGui_ImplQt_GetBackendStats();
+
+         // Queues of objects which are not rendered remain bounded
+         QCOMPARE(stats.RegisteredObjects, 2);
+         QVERIFY2(stats.MaxQueuedEvents <= stats.QueueCapacity,
+                  qPrintable(QString("%1 queued events, of %2")
+                                .arg(stats.MaxQueuedEvents)
+                                .arg(stats.QueueCapacity)));
+
+         queueCapacity = stats.QueueCapacity;
+         sample.queuedEvents_ += stats.QueuedEvents;
+         sample.droppedEvents_ += stats.DroppedEvents;
+
+         DestroyContext(context);
+      }
+
+      sample.residentBytes_ = ResidentBytes();
+      sample.newFrameTime_  = Percentile(newFrameTimes, 0.99);
+      samples.push_back(sample);
+
+      qInfo("Round %d: RSS %.1f MiB, %zu queued events, %llu dropped, "
+            "NewFrame p99 %.3f ms",
+            round,
+            sample.residentBytes_ / (1024.0 * 1024.0),
+            sample.queuedEvents_,
+            static_cast<unsigned long long>(sample.droppedEvents_),
+            sample.newFrameTime_ * 1000.0);
+   }
+
+   std::vector<double> residentBytes;
+   std::vector<double> queuedEvents;
+   std::vector<double> newFrameTimes;
+   for (std::size_t i = kWarmupRounds_; i < samples.size(); ++i)
+   {
+      residentBytes.push_back(samples[i].residentBytes_);
+      queuedEvents.push_back(static_cast<double>(samples[i].queuedEvents_));
+      newFrameTimes.push_back(samples[i].newFrameTime_);
+   }
+
+   const double measuredRounds = static_cast<double>(residentBytes.size() - 1);
+
+   // Resident memory does not grow beyond allocator noise
+   if (residentBytes.front() > 0.0)
+   {
+      const double growth    = Slope(residentBytes) * measuredRounds;
+      const double tolerance = std::max(4.0 * 1024.0 * 1024.0,
+                                        0.05 * residentBytes.front());
+      QVERIFY2(growth < tolerance,
+               qPrintable(QString("Resident memory grew by %1 KiB")
+                             .arg(growth / 1024.0, 0, 'f', 1)));
+   }
+
+   // Queued events do not accumulate, beyond the capacity of a single queue
+   // per context
+   const double queueGrowth = Slope(queuedEvents) * measuredRounds;
+   QVERIFY2(queueGrowth <
+               static_cast<double>(kContextsPerRound_ * queueCapacity),
+            qPrintable(QString("Queued events grew by %1").arg(queueGrowth)));
+
+   // The p99 frame time does not grow by more than its median over rounds
+   const double p99       = Percentile(newFrameTimes, 0.5);
+   const double p99Growth = Slope(newFrameTimes) * measuredRounds;
+   QVERIFY2(p99Growth < p99 + 0.0005,
+            qPrintable(QString("NewFrame p99 grew by %1 ms, median %2 ms")
+                          .arg(p99Growth * 1000.0, 0, 'f', 3)
+                          .arg(p99 * 1000.0, 0, 'f', 3)));
+}
+
+void ImGuiQtSoakTest::CreateContext(ImGuiQtSoakContext& context)
+{
+   context.context_ = ImGui::CreateContext();
+   ImGui::SetCurrentContext(context.context_);
+
+   // Without a renderer, the font atlas is only built
+   unsigned char* pixels;
+   int            width;
+   int            height;
+   ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+   QVERIFY(ImGui_ImplQt_Init());
+
+   // Receives input, but is never rendered
+   context.idleWidget_ = std::make_unique<QWidget>();
+   context.idleWidget_->resize(320, 240);
+   ImGui_ImplQt_RegisterWidget(context.idleWidget_.get());
+   context.idleWidgetHandle_ =
+      ImGui_ImplQt_GetEventHandle(context.idleWidget_.get());
+
+   ReplaceWidget(context);
+}
+
+void ImGuiQtSoakTest::DestroyContext(ImGuiQtSoakContext& context)
+{
+   ImGui::SetCurrentContext(context.context_);
+
+   // Widgets are left registered, as applications commonly do
+   ImGui_ImplQt_Shutdown();
+   context.widget_.reset();
+   context.idleWidget_.reset();
+   context.widgetHandle_.reset();
+   context.idleWidgetHandle_.reset();
+
+   ImGui::DestroyContext(context.context_);
+   context.context_ = nullptr;
+}
+
+void ImGuiQtSoakTest::ReplaceWidget(ImGuiQtSoakContext& context)
+{
+   if (context.widget_ != nullptr)
+   {
+      ImGui_ImplQt_UnregisterWidget(context.widget_.get());
+   }
+
+   context.widget_ = std::make_unique<QWidget>();
+   context.widget_->resize(640, 480);
+   ImGui_ImplQt_RegisterWidget(context.widget_.get());
+   context.widgetHandle_ = ImGui_ImplQt_GetEventHandle(context.widget_.get());
+}
+
+void ImGuiQtSoakTest::Frame(QWidget* widget)
+{
+   static char text[64] {};
+
+   ImGui_ImplQt_NewFrame(widget);
+   ImGui::NewFrame();
+
+   ImGui::Begin("Soak");
+   ImGui::Button("Button");
+   ImGui::InputText("Text", text, sizeof(text));
+   ImGui::End();
+
+   ImGui::Render();
+}
+
+void ImGuiQtSoakTest::SendInput(QWidget* widget, int frame)
+{
+   const QPointF position(static_cast<qreal>(frame % 300),
+                          static_cast<qreal>((frame * 7) % 200));
+   const QPointF globalPosition = widget->mapToGlobal(position);
+
+   if (frame % kFramesPerWidget_ == 0)
+   {
+      QEnterEvent enterEvent(position, position, globalPosition);
+      QCoreApplication::sendEvent(widget, &enterEvent);
+
+      QFocusEvent focusInEvent(QEvent::Type::FocusIn);
+      QCoreApplication::sendEvent(widget, &focusInEvent);
+   }
+
+   for (int i = 0; i < 4; ++i)
+   {
+      QMouseEvent moveEvent(QEvent::Type::MouseMove,
+                            position + QPointF(i, i),
+                            globalPosition + QPointF(i, i),
+                            Qt::MouseButton::NoButton,
+                            Qt::MouseButton::NoButton,
+                            Qt::KeyboardModifier::NoModifier);
+      QCoreApplication::sendEvent(widget, &moveEvent);
+   }
+
+   if (frame % 5 == 0)
+   {
+      QMouseEvent pressEvent(QEvent::Type::MouseButtonPress,
+                             position,
+                             globalPosition,
+                             Qt::MouseButton::LeftButton,
+                             Qt::MouseButton::LeftButton,
+                             Qt::KeyboardModifier::NoModifier);
+      QMouseEvent releaseEvent(QEvent::Type::MouseButtonRelease,
+                               position,
+                               globalPosition,
+                               Qt::MouseButton::LeftButton,
+                               Qt::MouseButton::NoButton,
+                               Qt::KeyboardModifier::NoModifier);
+      QCoreApplication::sendEvent(widget, &pressEvent);
+      QCoreApplication::sendEvent(widget, &releaseEvent);
+
+      QWheelEvent wheelEvent(position,
+                             globalPosition,
+                             QPoint(),
+                             QPoint(0, 120),
+                             Qt::MouseButton::NoButton,
+                             Qt::KeyboardModifier::NoModifier,
+                             Qt::ScrollPhase::NoScrollPhase,
+                             false);
+      QCoreApplication::sendEvent(widget, &wheelEvent);
+   }
+
+   QKeyEvent keyPressEvent(QEvent::Type::KeyPress,
+                           Qt::Key::Key_A,
+                           Qt::KeyboardModifier::NoModifier,
+                           QStringLiteral("a"));
+   QKeyEvent keyReleaseEvent(QEvent::Type::KeyRelease,
+                             Qt::Key::Key_A,
+                             Qt::KeyboardModifier::NoModifier,
+                             QStringLiteral("a"));
+   QCoreApplication::sendEvent(widget, &keyPressEvent);
+   QCoreApplication::sendEvent(widget, &keyReleaseEvent);
+
+   if (frame % kFramesPerWidget_ == kFramesPerWidget_ / 2)
+   {
+      QFocusEvent focusOutEvent(QEvent::Type::FocusOut);
+      QCoreApplication::sendEvent(widget, &focusOutEvent);
+
+      QEvent leaveEvent(QEvent::Type::Leave);
+      QCoreApplication::sendEvent(widget, &leaveEvent);
+   }
+}
+
+double ImGuiQtSoakTest::ResidentBytes()
+{
+#ifdef Q_OS_LINUX
+   // Second field of statm is the resident set size, in pages
+   QFile statm("/proc/self/statm");
+   if (statm.open(QIODevice::OpenModeFlag::ReadOnly))
+   {
+      const QList<QByteArray> fields = statm.readAll().split(' ');
+      if (fields.size() > 1)
+      {
+         return fields[1].toDouble() *
+                static_cast<double>(sysconf(_SC_PAGESIZE));
+      }
+   }
+#endif
+
+   // Resident memory is not checked on other platforms
+   return 0.0;
+}
+
+double ImGuiQtSoakTest::Slope(const std::vector<double>& samples)
+{
+   // Least squares slope, per sample
+   const double n     = static_cast<double>(samples.size());
+   const double meanX = (n - 1.0) / 2.0;
+   const double meanY = Mean(samples);
+
+   double covariance = 0.0;
+   double variance   = 0.0;
+   for (std::size_t i = 0; i < samples.size(); ++i)
+   {
+      const double dx = static_cast<double>(i) - meanX;
+      covariance += dx * (samples[i] - meanY);
+      variance += dx * dx;
+   }
+
+   return variance > 0.0 ? covariance / variance : 0.0;
+}
+
+double ImGuiQtSoakTest::Mean(const std::vector<double>& samples)
+{
+   return samples.empty() ?
+             0.0 :
+             std::accumulate(samples.cbegin(), samples.cend(), 0.0) /
+                static_cast<double>(samples.size());
+}
+
+double ImGuiQtSoakTest::Percentile(std::vector<double> samples,
+                                   double              percentile)
+{
+   if (samples.empty())
+   {
+      return 0.0;
+   }
+
+   // Nearest rank
+   const std::size_t rank = static_cast<std::size_t>(
+      std::ceil(percentile * static_cast<double>(samples.size())));
+   auto nth = samples.begin() + (std::max<std::size_t>(rank, 1u) - 1u);
+   std::nth_element(samples.begin(), nth, samples.end());
+   return *nth;
+}
+
+int main(int argc, char* argv[])
+{
+   // Headless, unless another platform is requested
+   if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+   {
+      qputenv("QT_QPA_PLATFORM", "offscreen");
+   }
+
+   QApplication    app(argc, argv);
+   ImGuiQtSoakTest test;
+   return QTest::qExec(&test, argc, argv);
+}
+
+#include "soak_test.moc"